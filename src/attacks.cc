@@ -0,0 +1,296 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file attacks.cc
+//! @author Omar A Serrano
+//! @date 2016-10-15
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <cstdint>
+#include <vector>
+
+//
+// zoor
+//
+#include "attacks.hh"
+#include "basicboard.hh"
+#include "basictypes.hh"
+#include "bitboard.hh"
+
+namespace zoor {
+
+namespace {
+
+//
+// magic numbers found by Attacks::Init from its seed, so that the tables can
+// be filled without searching for them
+//
+const uint64_t BISHOP_MAGIC[64] = {
+  0x0808010404140020ULL, 0x0002100400808846ULL, 0x00911c0082000000ULL,
+  0x0004105200030000ULL, 0x4201104000e04000ULL, 0x0080901088011000ULL,
+  0xa006008404c14018ULL, 0x02001105080a4041ULL, 0x40004e0c04040c10ULL,
+  0x0042a10809104080ULL, 0x000010012a083120ULL, 0x0200420a02000401ULL,
+  0x0008011040100000ULL, 0x3024408804414400ULL, 0x362000b20802400aULL,
+  0x0800a04108011004ULL, 0x00d0c00420121410ULL, 0x0089148418082040ULL,
+  0x2409001800440480ULL, 0x0003041024028024ULL, 0xa244008201210060ULL,
+  0x0803000080414000ULL, 0x8450407088241000ULL, 0x1010802024240220ULL,
+  0x50300a1c41220404ULL, 0x2044042002f02400ULL, 0x4200410130040081ULL,
+  0x0264040104401180ULL, 0x1101010010104000ULL, 0x00a0410086010120ULL,
+  0xa04c012008880100ULL, 0x2000810002010090ULL, 0x1010252000060708ULL,
+  0x1024012000080210ULL, 0x5081014500881800ULL, 0x2880340109040100ULL,
+  0x4021080200902200ULL, 0x0020158500806401ULL, 0x00a4012040041400ULL,
+  0x00008300484b0400ULL, 0x22010c2020080682ULL, 0x0c04040144800802ULL,
+  0x000e402410010100ULL, 0x0021204200800800ULL, 0x2180400891000a00ULL,
+  0x4001105102000040ULL, 0x080806040d401410ULL, 0xe8020c8122040100ULL,
+  0x0002010108400101ULL, 0x0000828c10020008ULL, 0x001c060101210060ULL,
+  0x00400000420210a4ULL, 0x0022001002021402ULL, 0x0400430a24090300ULL,
+  0x1208229404240200ULL, 0x0304301411042000ULL, 0x1109008210324200ULL,
+  0x0461021088941000ULL, 0x42840211008a4100ULL, 0x2880000400420200ULL,
+  0x4080010010220880ULL, 0x4020005044580824ULL, 0x220d40484240a603ULL,
+  0x2011021804408200ULL
+};
+
+const uint64_t ROOK_MAGIC[64] = {
+  0x5080054001203180ULL, 0x0040400020001000ULL, 0x4180200180300019ULL,
+  0x8100210004081000ULL, 0xc600080420100200ULL, 0x0200241200032830ULL,
+  0x1480800081000200ULL, 0x0100110003408822ULL, 0x8004800020884001ULL,
+  0x0000802000400088ULL, 0x6002001604804020ULL, 0x0802000c10420020ULL,
+  0x0202800400080281ULL, 0x4002800200800400ULL, 0x2240808001000200ULL,
+  0x0002002080440102ULL, 0x01c0808000204006ULL, 0x2010004020004000ULL,
+  0x0830010100200040ULL, 0x0040220040100a00ULL, 0x2468004040040200ULL,
+  0x40a2008080040002ULL, 0x0005410100020004ULL, 0x0011820001008044ULL,
+  0xc640400080009020ULL, 0x0040500840002000ULL, 0x0022008200201040ULL,
+  0x0105002100100108ULL, 0x0000080080040081ULL, 0x0440040080020080ULL,
+  0x0402320400111088ULL, 0x180480218002c100ULL, 0x0120804000800020ULL,
+  0x6142010386004220ULL, 0x0612008042001020ULL, 0x0080200a02004010ULL,
+  0x0001001005000800ULL, 0x0018040080800200ULL, 0x0000d10a0c004810ULL,
+  0x0000889442002104ULL, 0x4100408102020022ULL, 0x0022028102260040ULL,
+  0x02a1004020010010ULL, 0x8840100008008080ULL, 0x4000080004008080ULL,
+  0x9024000402008080ULL, 0xa424040200010100ULL, 0x8480074424860011ULL,
+  0x2100800020401880ULL, 0x2900400080200080ULL, 0x2000188200402200ULL,
+  0x4d00100080080080ULL, 0x2004080080040080ULL, 0x2208800400020080ULL,
+  0x440100220014b100ULL, 0x250020a400410200ULL, 0x204a102100800041ULL,
+  0x0022023320830042ULL, 0x5008402001001409ULL, 0x0080100005002009ULL,
+  0x000a006004081006ULL, 0x4411000204000801ULL, 0x0000061088104504ULL,
+  0x840c010024004092ULL
+};
+
+} // namespace
+
+//
+// init static vars
+//
+bitboard_t Attacks::sKnight[64];
+bitboard_t Attacks::sKing[64];
+bitboard_t Attacks::sPawn[2][64];
+Attacks::Magic Attacks::sBishop[64];
+Attacks::Magic Attacks::sRook[64];
+bitboard_t Attacks::sBishopTable[0x1480];
+bitboard_t Attacks::sRookTable[0x19000];
+bitboard_t Attacks::sBetween[64][64];
+bitboard_t Attacks::sLine[64][64];
+
+//
+// Fills the tables of knights, kings and pawns from the jump deltas of each
+// piece, skipping the jumps that fall off the board. Fills the tables of
+// bishops and rooks by walking their rays for every combination of blockers.
+// The magic numbers are checked before they are used, and if one does not work,
+// e.g., after a change to the tables, another is found with a trial and error
+// search from a fixed seed. The squares between two squares, and the line
+// through them, are found by walking the rays of a queen.
+//
+struct Attacks::Init
+{
+  Init() noexcept
+  {
+    static const dim_t KNIGHT[8][2] = {
+      {2, 1}, {1, 2}, {-1, 2}, {-2, 1},
+      {-2, -1}, {-1, -2}, {1, -2}, {2, -1}
+    };
+    static const dim_t KING[8][2] = {
+      {1, 0}, {1, 1}, {0, 1}, {-1, 1},
+      {-1, 0}, {-1, -1}, {0, -1}, {1, -1}
+    };
+    static const dim_t WHITE_PAWN[2][2] = {{1, -1}, {1, 1}};
+    static const dim_t BLACK_PAWN[2][2] = {{-1, -1}, {-1, 1}};
+
+    for (dim_t row = 0; row < BasicBoard::DIM; ++row) {
+      for (dim_t col = 0; col < BasicBoard::DIM; ++col) {
+        auto index = squareIndex(row, col);
+        sKnight[index] = mask(row, col, KNIGHT);
+        sKing[index] = mask(row, col, KING);
+        sPawn[0][index] = mask(row, col, WHITE_PAWN);
+        sPawn[1][index] = mask(row, col, BLACK_PAWN);
+      }
+    }
+
+    static const dim_t BISHOP[4][2] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+    static const dim_t ROOK[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+    initSlider(BISHOP, BISHOP_MAGIC, sBishop, sBishopTable);
+    initSlider(ROOK, ROOK_MAGIC, sRook, sRookTable);
+
+    // the lines go in the directions of the steps of a king
+    for (dim_t index = 0; index < 64; ++index) {
+      dim_t row = index / BasicBoard::DIM;
+      dim_t col = index % BasicBoard::DIM;
+      for (auto &dir : KING) {
+        // the whole line, walking both ways from the square
+        bitboard_t line = squareMask(index);
+        for (int sign = -1; sign <= 1; sign += 2) {
+          dim_t toRow = row + sign * dir[0];
+          dim_t toCol = col + sign * dir[1];
+          for (; BasicBoard::inBoard(toRow, toCol);
+               toRow += sign * dir[0], toCol += sign * dir[1])
+            line |= squareMask(toRow, toCol);
+        }
+
+        bitboard_t between = 0;
+        dim_t toRow = row + dir[0];
+        dim_t toCol = col + dir[1];
+        for (; BasicBoard::inBoard(toRow, toCol);
+             toRow += dir[0], toCol += dir[1]) {
+          auto to = squareIndex(toRow, toCol);
+          sBetween[index][to] = between;
+          sLine[index][to] = line;
+          between |= squareMask(to);
+        }
+      }
+    }
+  }
+
+  // the squares attacked along the rays, up to the first blocker
+  static bitboard_t
+  rays(dim_t row, dim_t col, const dim_t (&dirs)[4][2], bitboard_t occupied)
+    noexcept
+  {
+    bitboard_t bits = 0;
+    for (auto &dir : dirs) {
+      dim_t toRow = row + dir[0];
+      dim_t toCol = col + dir[1];
+      for (; BasicBoard::inBoard(toRow, toCol);
+           toRow += dir[0], toCol += dir[1]) {
+        bits |= squareMask(toRow, toCol);
+        if (occupied & squareMask(toRow, toCol))
+          break;
+      }
+    }
+    return bits;
+  }
+
+  // the squares along the rays that can block, i.e., without the edges
+  static bitboard_t
+  relevant(dim_t row, dim_t col, const dim_t (&dirs)[4][2]) noexcept
+  {
+    bitboard_t bits = 0;
+    for (auto &dir : dirs) {
+      dim_t toRow = row + dir[0];
+      dim_t toCol = col + dir[1];
+      for (; BasicBoard::inBoard(toRow + dir[0], toCol + dir[1]);
+           toRow += dir[0], toCol += dir[1])
+        bits |= squareMask(toRow, toCol);
+    }
+    return bits;
+  }
+
+  // a random number with few bits set, which makes a better magic
+  static uint64_t
+  sparse(uint64_t &state) noexcept
+  {
+    return next(state) & next(state) & next(state);
+  }
+
+  static uint64_t
+  next(uint64_t &state) noexcept
+  {
+    auto z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+
+  static void
+  initSlider(const dim_t (&dirs)[4][2],
+             const uint64_t (&known)[64],
+             Magic (&magics)[64],
+             bitboard_t *table)
+  {
+    std::vector<bitboard_t> occupancy, reference;
+#ifndef ZOOR_USE_PEXT
+    uint64_t state = 0x6d61676963ULL;
+    std::vector<unsigned> epoch;
+#endif
+
+    for (dim_t index = 0; index < 64; ++index) {
+      dim_t row = index / BasicBoard::DIM;
+      dim_t col = index % BasicBoard::DIM;
+      auto &m = magics[index];
+      m.mask = relevant(row, col, dirs);
+      m.shift = 64 - popCount(m.mask);
+      m.attacks = table;
+
+      // every subset of the relevant squares, and its attack set
+      occupancy.clear();
+      reference.clear();
+      bitboard_t subset = 0;
+      do {
+        occupancy.push_back(subset);
+        reference.push_back(rays(row, col, dirs, subset));
+        subset = (subset - m.mask) & m.mask;
+      } while (subset);
+      table += occupancy.size();
+
+#ifdef ZOOR_USE_PEXT
+      (void) known;
+      m.magic = 0;
+      for (size_t i = 0; i < occupancy.size(); ++i)
+        m.attacks[m.index(occupancy[i])] = reference[i];
+#else
+      // try magic numbers, starting with the known one, until one maps no two
+      // subsets with different attack sets to the same index; the epoch of an
+      // index tells if it was used by the current try, so the attack sets need
+      // not be cleared between tries
+      epoch.assign(occupancy.size(), 0);
+      for (unsigned tries = 1; ; ++tries) {
+        if (tries == 1)
+          m.magic = known[index];
+        else {
+          do
+            m.magic = sparse(state);
+          while (popCount((m.mask * m.magic) >> 56) < 6);
+        }
+
+        size_t i = 0;
+        for (; i < occupancy.size(); ++i) {
+          auto idx = m.index(occupancy[i]);
+          if (epoch[idx] < tries) {
+            epoch[idx] = tries;
+            m.attacks[idx] = reference[i];
+          } else if (m.attacks[idx] != reference[i])
+            break;
+        }
+        if (i == occupancy.size())
+          break;
+      }
+#endif
+    }
+  }
+
+  template<size_t N>
+  static bitboard_t
+  mask(dim_t row, dim_t col, const dim_t (&jumps)[N][2]) noexcept
+  {
+    bitboard_t bits = 0;
+    for (auto &jump : jumps) {
+      dim_t toRow = row + jump[0];
+      dim_t toCol = col + jump[1];
+      if (BasicBoard::inBoard(toRow, toCol))
+        bits |= squareMask(toRow, toCol);
+    }
+    return bits;
+  }
+};
+
+const Attacks::Init Attacks::sInit;
+
+} // namespace zoor
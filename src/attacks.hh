@@ -0,0 +1,273 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file attacks.hh
+//! @author Omar A Serrano
+//! @date 2016-10-15
+//! @details Precomputed attack sets. The squares attacked by a knight, a king,
+//! or a pawn depend only on the square where the piece stands, so they are
+//! computed once for every square, and finding them is a table lookup. An
+//! attack set is a bitboard, with the same square indexes as @c BitBoard.
+//!
+//! The squares attacked by a bishop or a rook also depend on the pieces that
+//! block its rays, but only on the pieces on the relevant squares of the rays,
+//! i.e., excluding the square at the edge of the board. The attack sets for
+//! every combination of blockers are computed once, and the index of the
+//! combination is found from the occupied squares in one of two ways, chosen
+//! at build time:
+//! @li By default, with magic bitboards: the relevant occupied squares are
+//! multiplied by a magic number, found when the tables are filled, which maps
+//! every combination to a unique index in the high bits of the product.
+//! @li If @c ZOOR_USE_PEXT is defined, with the BMI2 instruction PEXT, which
+//! gathers the bits of the relevant occupied squares into the low bits of the
+//! index. The CPU must support BMI2.
+//!
+//! The squares between two squares, and the line through them, are also kept
+//! for every pair of squares, to find pins and the squares that block a check.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _ATTACKS_H
+#define _ATTACKS_H
+
+//
+// STL
+//
+#include <cassert>
+#include <cstddef>
+
+#ifdef ZOOR_USE_PEXT
+#include <immintrin.h>
+#endif
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "bitboard.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Attacks contains the static tables of attack sets.
+//! @details Copy control for Attacks has been removed, because it is not meant
+//! to be instantiated. The tables are filled before main() runs.
+struct Attacks
+{
+  // Remove copy control
+  Attacks() = delete;
+  Attacks(const Attacks&) = delete;
+  Attacks(Attacks&&) = delete;
+  Attacks& operator=(const Attacks&) = delete;
+  Attacks& operator=(Attacks&&) = delete;
+
+  //! @param index The index of the square where the knight stands.
+  //! @return The squares attacked by the knight.
+  //! @throw Never throws.
+  static bitboard_t
+  knight(dim_t index) noexcept;
+
+  //! @param index The index of the square where the king stands.
+  //! @return The squares attacked by the king.
+  //! @throw Never throws.
+  static bitboard_t
+  king(dim_t index) noexcept;
+
+  //! @param color The color of the pawn.
+  //! @param index The index of the square where the pawn stands.
+  //! @return The squares attacked by the pawn.
+  //! @throw Never throws.
+  static bitboard_t
+  pawn(Color color, dim_t index) noexcept;
+
+  //! @param index The index of the square where the bishop stands.
+  //! @param occupied The occupied squares.
+  //! @return The squares attacked by the bishop, up to and including the first
+  //! occupied square in each direction.
+  //! @throw Never throws.
+  static bitboard_t
+  bishop(dim_t index, bitboard_t occupied) noexcept;
+
+  //! @param index The index of the square where the rook stands.
+  //! @param occupied The occupied squares.
+  //! @return The squares attacked by the rook, up to and including the first
+  //! occupied square in each direction.
+  //! @throw Never throws.
+  static bitboard_t
+  rook(dim_t index, bitboard_t occupied) noexcept;
+
+  //! @param index The index of the square where the queen stands.
+  //! @param occupied The occupied squares.
+  //! @return The squares attacked by the queen, up to and including the first
+  //! occupied square in each direction.
+  //! @throw Never throws.
+  static bitboard_t
+  queen(dim_t index, bitboard_t occupied) noexcept;
+
+  //! @param from The index of the first square.
+  //! @param to The index of the second square.
+  //! @return The squares strictly between the two squares, if they are on the
+  //! same row, column or diagonal, or zero otherwise.
+  //! @throw Never throws.
+  static bitboard_t
+  between(dim_t from, dim_t to) noexcept;
+
+  //! @param from The index of the first square.
+  //! @param to The index of the second square.
+  //! @return The squares of the whole row, column or diagonal through the two
+  //! squares, from edge to edge, or zero if they are not on one or if they are
+  //! the same square.
+  //! @throw Never throws.
+  static bitboard_t
+  line(dim_t from, dim_t to) noexcept;
+
+private:
+  // The attack sets of a sliding piece on one square.
+  struct Magic
+  {
+    // The relevant squares.
+    bitboard_t mask;
+
+    // The magic number, unused with PEXT.
+    bitboard_t magic;
+
+    // The attack sets, indexed by the combination of blockers.
+    bitboard_t *attacks;
+
+    // The shift of the product to its high bits, unused with PEXT.
+    unsigned shift;
+
+    size_t
+    index(bitboard_t occupied) const noexcept;
+  };
+
+  // Fills the tables.
+  struct Init;
+
+  // Fills the tables before main() runs.
+  static const Init sInit;
+
+  // Squares attacked by a knight, indexed by square.
+  static bitboard_t sKnight[64];
+
+  // Squares attacked by a king, indexed by square.
+  static bitboard_t sKing[64];
+
+  // Squares attacked by a pawn, indexed by color and square.
+  static bitboard_t sPawn[2][64];
+
+  // The attack sets of bishops and rooks, indexed by square.
+  static Magic sBishop[64];
+  static Magic sRook[64];
+
+  // The storage for the attack sets of bishops and rooks on every square.
+  static bitboard_t sBishopTable[0x1480];
+  static bitboard_t sRookTable[0x19000];
+
+  // Squares between two squares, and the line through them, indexed by the
+  // two squares.
+  static bitboard_t sBetween[64][64];
+  static bitboard_t sLine[64][64];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// squares attacked by a knight
+//
+inline bitboard_t
+Attacks::knight(dim_t index) noexcept
+{
+  assert(index >= 0 and index < 64);
+  return sKnight[index];
+}
+
+//
+// squares attacked by a king
+//
+inline bitboard_t
+Attacks::king(dim_t index) noexcept
+{
+  assert(index >= 0 and index < 64);
+  return sKing[index];
+}
+
+//
+// squares attacked by a pawn
+//
+inline bitboard_t
+Attacks::pawn(Color color, dim_t index) noexcept
+{
+  assert(index >= 0 and index < 64);
+  return sPawn[colorIndex(color)][index];
+}
+
+//
+// squares attacked by a bishop
+//
+inline bitboard_t
+Attacks::bishop(dim_t index, bitboard_t occupied) noexcept
+{
+  assert(index >= 0 and index < 64);
+  auto &m = sBishop[index];
+  return m.attacks[m.index(occupied)];
+}
+
+//
+// squares attacked by a rook
+//
+inline bitboard_t
+Attacks::rook(dim_t index, bitboard_t occupied) noexcept
+{
+  assert(index >= 0 and index < 64);
+  auto &m = sRook[index];
+  return m.attacks[m.index(occupied)];
+}
+
+//
+// squares attacked by a queen
+//
+inline bitboard_t
+Attacks::queen(dim_t index, bitboard_t occupied) noexcept
+{
+  return bishop(index, occupied) | rook(index, occupied);
+}
+
+//
+// squares between two squares
+//
+inline bitboard_t
+Attacks::between(dim_t from, dim_t to) noexcept
+{
+  assert(from >= 0 and from < 64);
+  assert(to >= 0 and to < 64);
+  return sBetween[from][to];
+}
+
+//
+// line through two squares
+//
+inline bitboard_t
+Attacks::line(dim_t from, dim_t to) noexcept
+{
+  assert(from >= 0 and from < 64);
+  assert(to >= 0 and to < 64);
+  return sLine[from][to];
+}
+
+//
+// index of the attack set for the occupied squares
+//
+inline size_t
+Attacks::Magic::index(bitboard_t occupied) const noexcept
+{
+#ifdef ZOOR_USE_PEXT
+  return _pext_u64(occupied, mask);
+#else
+  return ((occupied & mask) * magic) >> shift;
+#endif
+}
+
+} // namespace zoor
+#endif // _ATTACKS_H
@@ -11,12 +11,14 @@
 //
 #include <algorithm>
 #include <cassert>
+#include <type_traits>
 #include <utility>
 
 //
 // zoor
 //
 #include "basictypes.hh"
+#include "bitboard.hh"
 
 namespace zoor {
 
@@ -56,36 +58,40 @@ public:
   using const_iterator = const piece_t*;
 
   //! @details Initializes the board with the normal setup for beginning game.
-  //! @throw May throw bad memory allocation.
-  BasicBoard();
+  //! @throw Never throws.
+  BasicBoard() noexcept;
 
-  //! @brief Copy ctor.
+  //! @brief Default copy ctor.
+  //! @details The squares are stored inline, so copying a board is a plain
+  //! memory copy without any allocation.
   //! @param board The board to be copied.
-  //! @throw May throw bad memory allocation.
-  BasicBoard(const BasicBoard &board);
+  //! @throw Never throws.
+  BasicBoard(const BasicBoard &board) noexcept = default;
 
-  //! @brief Move ctor.
+  //! @brief Default move ctor.
+  //! @details Same as the copy ctor; the moved board is left unchanged.
   //! @param board The board being moved.
   //! @throw Never throws.
-  BasicBoard(BasicBoard &&board) noexcept;
+  BasicBoard(BasicBoard &&board) noexcept = default;
 
-  //! @brief Copy assignment.
+  //! @brief Default copy assignment.
   //! @param board The board being assigned.
   //! @return A reference to @c BasicBoard.
   //! @throw Never throws.
   BasicBoard&
-  operator=(const BasicBoard &board) noexcept;
+  operator=(const BasicBoard &board) noexcept = default;
 
-  //! @brief Move assignment.
+  //! @brief Default move assignment.
+  //! @details Same as copy assignment; the moved board is left unchanged.
   //! @param board The board being moved.
   //! @return A reference to @c BasicBoard.
   //! @throw Never throws.
   BasicBoard&
-  operator=(BasicBoard &&board) noexcept;
+  operator=(BasicBoard &&board) noexcept = default;
 
-  //! @brief Dtor.
+  //! @brief Default dtor.
   //! @throw Never throws.
-  ~BasicBoard() noexcept;
+  ~BasicBoard() noexcept = default;
 
   //! @brief Obtain the contents of a given square.
   //! @param row The row of the square.
@@ -119,14 +125,16 @@ public:
   void
   put(dim_t row, dim_t column, Piece piece, Color color) noexcept;
 
-  //! @brief Get iterator to the first square on the board.
+  //! @brief Get read only iterator to the first square on the board.
+  //! @details Squares can only be changed with put() and clear(), which keep
+  //! the bitboards in sync.
   //! @throw Never throws.
-  iterator
+  const_iterator
   begin() const noexcept;
 
-  //! @brief Get iterator to one past the last square.
+  //! @brief Get read only iterator to one past the last square.
   //! @throw Never throws.
-  iterator
+  const_iterator
   end() const noexcept;
 
   //! @brief Get read only iterator to the first square on the board.
@@ -139,6 +147,14 @@ public:
   const_iterator
   cend() const noexcept;
 
+  //! @brief Get the bitboards for the pieces on the board.
+  //! @details The bitboards are kept in sync with the squares every time a
+  //! square is changed with put() or clear().
+  //! @return A const reference to the bitboards.
+  //! @throw Never throws.
+  const BitBoard&
+  bits() const noexcept;
+
   //! @brief Check that row and column are less than BasicBoard::DIM.
   //! @param row The row number.
   //! @brief column The column number.
@@ -148,21 +164,28 @@ public:
   inBoard(dim_t row, dim_t column) noexcept;
 
   //! @return Return a board without any pieces.
+  //! @throw Never throws.
   static BasicBoard
-  emptyBoard();
+  emptyBoard() noexcept;
 
 private:
   // Dummy type to indicate to compiler to construct empty board.
   enum class InitEmpty { INIT };
 
   // Return a board without any pieces.
-  BasicBoard(InitEmpty);
+  BasicBoard(InitEmpty) noexcept;
 
-  // Pointer to the array.
-  piece_t *mArr;
+  // The squares, aligned to fit in a single cache line.
+  alignas(64) piece_t mArr[SIZE];
+
+  // The bitboards for the pieces in the array.
+  BitBoard mBits;
 
 };
 
+static_assert(std::is_trivially_copyable<BasicBoard>::value,
+              "BasicBoard must be copied without allocation");
+
 //! @brief Equality operator for two boards.
 //! @param board1 The left hand board.
 //! @param board2 The right hand board.
@@ -198,74 +221,21 @@ index(dim_t row, dim_t column) noexcept
 // Default ctor.
 //
 inline
-BasicBoard::BasicBoard()
-  : mArr(new piece_t[64])
-{
-  std::copy(std::begin(INIT_BOARD), std::end(INIT_BOARD), begin());
-}
-
-//
-// Copy ctor.
-//
-inline
-BasicBoard::BasicBoard(const BasicBoard &board)
-  : mArr(new piece_t[64])
-{
-  assert(board.mArr != nullptr);
-  std::copy(board.begin(), board.end(), begin());
-}
-
-//
-// Move ctor.
-//
-inline
-BasicBoard::BasicBoard(BasicBoard &&board) noexcept
-  : mArr(board.mArr)
+BasicBoard::BasicBoard() noexcept
 {
-  assert(mArr != nullptr);
-  board.mArr = nullptr;
-}
-
-//
-// Copy Assignment.
-//
-inline BasicBoard&
-BasicBoard::operator=(const BasicBoard &board) noexcept
-{
-  assert(mArr != nullptr);
-  assert(board.mArr != nullptr);
-  std::copy(board.begin(), board.end(), begin());
-  return *this;
-}
-
-//
-// Move assignment.
-//
-inline BasicBoard&
-BasicBoard::operator=(BasicBoard &&board) noexcept
-{
-  assert(mArr != nullptr);
-  assert(board.mArr != nullptr);
-  std::swap(mArr, board.mArr);
-  return *this;
-}
-
-//
-// Dtor.
-//
-inline
-BasicBoard::~BasicBoard() noexcept
-{
-  if (mArr != nullptr)
-    delete[] mArr;
+  std::copy(std::begin(INIT_BOARD), std::end(INIT_BOARD), std::begin(mArr));
+  for (dim_t i = 0; i < SIZE; ++i) {
+    if (not notPiece(mArr[i]))
+      mBits.add(i, mArr[i]);
+  }
 }
 
 //
 // Blank board ctor.
 //
 inline
-BasicBoard::BasicBoard(InitEmpty)
-  : mArr(new piece_t[SIZE]()) {}
+BasicBoard::BasicBoard(InitEmpty) noexcept
+  : mArr() {}
 
 //
 // get the piece from a given square
@@ -273,7 +243,6 @@ BasicBoard::BasicBoard(InitEmpty)
 inline piece_t
 BasicBoard::get(dim_t row, dim_t column) const noexcept
 {
-  assert(mArr != nullptr);
   assert(inBoard(row, column));
   return mArr[index(row, column)];
 }
@@ -284,9 +253,11 @@ BasicBoard::get(dim_t row, dim_t column) const noexcept
 inline void
 BasicBoard::clear(dim_t row, dim_t column) noexcept
 {
-  assert(mArr != nullptr);
   assert(inBoard(row, column));
-  mArr[index(row, column)] = 0;
+  auto i = index(row, column);
+  if (isPiece(mArr[i]) and not notColor(mArr[i]))
+    mBits.remove(i, mArr[i]);
+  mArr[i] = 0;
 }
 
 //
@@ -295,9 +266,13 @@ BasicBoard::clear(dim_t row, dim_t column) noexcept
 inline void
 BasicBoard::put(dim_t row, dim_t column, piece_t piece) noexcept
 {
-  assert(mArr != nullptr);
   assert(inBoard(row, column));
-  mArr[index(row, column)] = piece;
+  auto i = index(row, column);
+  if (isPiece(mArr[i]) and not notColor(mArr[i]))
+    mBits.remove(i, mArr[i]);
+  mArr[i] = piece;
+  if (isPiece(piece) and not notColor(piece))
+    mBits.add(i, piece);
 }
 
 //
@@ -306,28 +281,24 @@ BasicBoard::put(dim_t row, dim_t column, piece_t piece) noexcept
 inline void
 BasicBoard::put(dim_t row, dim_t column, Piece piece, Color color) noexcept
 {
-  assert(mArr != nullptr);
-  assert(inBoard(row, column));
-  mArr[index(row, column)] = color | piece;
+  put(row, column, color | piece);
 }
 
 //
 // return the begin iterator
 //
-inline BasicBoard::iterator
+inline BasicBoard::const_iterator
 BasicBoard::begin() const noexcept
 {
-  assert(mArr != nullptr);
   return mArr;
 }
 
 //
 // return the end iterator
 //
-inline BasicBoard::iterator
+inline BasicBoard::const_iterator
 BasicBoard::end() const noexcept
 {
-  assert(mArr != nullptr);
   return mArr + SIZE;
 }
 
@@ -337,7 +308,6 @@ BasicBoard::end() const noexcept
 inline BasicBoard::const_iterator
 BasicBoard::cbegin() const noexcept
 {
-  assert(mArr != nullptr);
   return mArr;
 }
 
@@ -347,15 +317,23 @@ BasicBoard::cbegin() const noexcept
 inline BasicBoard::const_iterator
 BasicBoard::cend() const noexcept
 {
-  assert(mArr != nullptr);
   return mArr + SIZE;
 }
 
+//
+// get the bitboards
+//
+inline const BitBoard&
+BasicBoard::bits() const noexcept
+{
+  return mBits;
+}
+
 //
 // create an empty board
 //
 inline BasicBoard
-BasicBoard::emptyBoard()
+BasicBoard::emptyBoard() noexcept
 {
   return BasicBoard(InitEmpty::INIT);
 }
@@ -24,6 +24,9 @@ using piece_t = uint8_t;
 //! @brief The type used for the dimension of a board.
 using dim_t = int16_t;
 
+//! @brief The type of a count of nodes in a tree of moves.
+using node_t = uint64_t;
+
 //! @brief Represents a piece on the board.
 //! @details Since each piece on a board is represented in a byte, the type for
 //! each Piece is an unsigned char.
@@ -174,6 +177,13 @@ isSame(piece_t code, Piece piece) noexcept;
 bool
 isSame(piece_t piece, Color color) noexcept;
 
+//
+// Function to get the material value of a Piece.
+//
+
+int
+pieceValue(Piece piece) noexcept;
+
 //
 // Output functions.
 //
@@ -499,5 +509,17 @@ inBound(dim_t row, dim_t col) noexcept
       and col >= 0 and col <= 7;
 }
 
+//! @brief Get the material value of a piece, in centipawns.
+//! @details The king has no material value, because it is never captured.
+//! @param piece The @c Piece.
+//! @return The value of the piece, or 0 for <em>Piece::NONE</em>.
+//! @throw Never throws.
+inline int
+pieceValue(Piece piece) noexcept
+{
+  static const int VALUE[] = {0, 100, 300, 300, 500, 900, 0};
+  return VALUE[static_cast<piece_t>(piece)];
+}
+
 } // namespace zoor
 #endif // _BASICTYPES_H
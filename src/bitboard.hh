@@ -0,0 +1,361 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file bitboard.hh
+//! @author Omar A Serrano
+//! @date 2016-10-02
+//! @details A bitboard is a set of squares stored in a 64 bit word, with one
+//! bit per square. Square a1 (row 0, column 0) is bit 0, h1 is bit 7, and h8
+//! (row 7, column 7) is bit 63, i.e., the bit index is row * 8 + column, which
+//! is the same layout used by the squares of a @c BasicBoard.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _BITBOARD_H
+#define _BITBOARD_H
+
+//
+// STL
+//
+#include <cassert>
+#include <cstdint>
+#include <initializer_list>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief A set of squares, one bit per square.
+using bitboard_t = uint64_t;
+
+//! @brief The index of a square in the range [0, 64).
+//! @param row The row of the square.
+//! @param column The column of the square.
+//! @return The index of the square.
+//! @throw Never throws.
+dim_t
+squareIndex(dim_t row, dim_t column) noexcept;
+
+//! @brief The bitboard with a single square.
+//! @param row The row of the square.
+//! @param column The column of the square.
+//! @return A bitboard with only the bit for the square turned on.
+//! @throw Never throws.
+bitboard_t
+squareMask(dim_t row, dim_t column) noexcept;
+
+//! @brief The bitboard with a single square.
+//! @param index The index of the square.
+//! @return A bitboard with only the bit for the square turned on.
+//! @throw Never throws.
+bitboard_t
+squareMask(dim_t index) noexcept;
+
+//! @param bits The bitboard.
+//! @return The number of squares in the bitboard.
+//! @throw Never throws.
+int
+popCount(bitboard_t bits) noexcept;
+
+//! @param bits A non-empty bitboard.
+//! @return The index of the least significant square in the bitboard.
+//! @throw Never throws.
+dim_t
+lsbIndex(bitboard_t bits) noexcept;
+
+//! @brief Remove the least significant square from a bitboard.
+//! @param bits A non-empty bitboard.
+//! @return The index of the square that was removed.
+//! @throw Never throws.
+dim_t
+popLsb(bitboard_t &bits) noexcept;
+
+//! @param color The color, which must not be Color::NONE.
+//! @return 0 for white, 1 for black.
+//! @throw Never throws.
+int
+colorIndex(Color color) noexcept;
+
+//! @param piece The piece, which must not be Piece::NONE.
+//! @return 0 for a pawn, 1 for a knight, and so on up to 5 for a king.
+//! @throw Never throws.
+int
+pieceIndex(Piece piece) noexcept;
+
+//! @brief The location of every piece on a board, kept as one bitboard per
+//! piece and color, plus one occupancy bitboard per color.
+//! @details A @c BitBoard does not know anything about the rules of chess. It
+//! is maintained by @c BasicBoard every time a square changes, and lets move
+//! generation and check detection work with whole sets of squares at once.
+class BitBoard
+{
+public:
+  //! @brief Default ctor.
+  //! @details Initializes an empty set of bitboards.
+  //! @throw Never throws.
+  BitBoard() noexcept;
+
+  //! @param color The color of the pieces.
+  //! @param piece The type of piece.
+  //! @return The squares occupied by the given piece of the given color.
+  //! @throw Never throws.
+  bitboard_t
+  pieces(Color color, Piece piece) const noexcept;
+
+  //! @param piece The type of piece.
+  //! @return The squares occupied by the given piece of either color.
+  //! @throw Never throws.
+  bitboard_t
+  pieces(Piece piece) const noexcept;
+
+  //! @param color The color of the pieces.
+  //! @return The squares occupied by pieces of the given color.
+  //! @throw Never throws.
+  bitboard_t
+  color(Color color) const noexcept;
+
+  //! @return The squares occupied by a piece of either color.
+  //! @throw Never throws.
+  bitboard_t
+  occupied() const noexcept;
+
+  //! @return The squares without a piece.
+  //! @throw Never throws.
+  bitboard_t
+  empty() const noexcept;
+
+  //! @brief Add a piece to a square.
+  //! @param index The index of the square, which must be empty.
+  //! @param code The piece code, with a valid piece and color.
+  //! @throw Never throws.
+  void
+  add(dim_t index, piece_t code) noexcept;
+
+  //! @brief Remove a piece from a square.
+  //! @param index The index of the square.
+  //! @param code The piece code of the piece on the square.
+  //! @throw Never throws.
+  void
+  remove(dim_t index, piece_t code) noexcept;
+
+private:
+  // One set per color and piece, indexed with colorIndex() and pieceIndex().
+  bitboard_t mPieces[2][6];
+
+  // One set per color with all the pieces of that color.
+  bitboard_t mColors[2];
+};
+
+//! @brief Equality operator for @c BitBoard.
+//! @param bits1 The left hand @c BitBoard.
+//! @param bits2 The right hand @c BitBoard.
+//! @return True if both contain the same pieces on the same squares.
+//! @throw Never throws.
+bool
+operator==(const BitBoard &bits1, const BitBoard &bits2) noexcept;
+
+//! @brief Non-equality operator for @c BitBoard.
+//! @param bits1 The left hand @c BitBoard.
+//! @param bits2 The right hand @c BitBoard.
+//! @return True if the bitboards are not equal.
+//! @throw Never throws.
+bool
+operator!=(const BitBoard &bits1, const BitBoard &bits2) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// index of a square
+//
+inline dim_t
+squareIndex(dim_t row, dim_t column) noexcept
+{
+  assert(inBound(row, column));
+  return row * 8 + column;
+}
+
+//
+// bitboard from row and column
+//
+inline bitboard_t
+squareMask(dim_t row, dim_t column) noexcept
+{
+  return bitboard_t(1) << squareIndex(row, column);
+}
+
+//
+// bitboard from index
+//
+inline bitboard_t
+squareMask(dim_t index) noexcept
+{
+  assert(index >= 0 and index < 64);
+  return bitboard_t(1) << index;
+}
+
+//
+// count the squares in a bitboard
+//
+inline int
+popCount(bitboard_t bits) noexcept
+{
+  return __builtin_popcountll(bits);
+}
+
+//
+// index of the least significant square
+//
+inline dim_t
+lsbIndex(bitboard_t bits) noexcept
+{
+  assert(bits != 0);
+  return static_cast<dim_t>(__builtin_ctzll(bits));
+}
+
+//
+// remove and return the least significant square
+//
+inline dim_t
+popLsb(bitboard_t &bits) noexcept
+{
+  auto index = lsbIndex(bits);
+  bits &= bits - 1;
+  return index;
+}
+
+//
+// index for a color
+//
+inline int
+colorIndex(Color color) noexcept
+{
+  assert(not notColor(color));
+  return isWhite(color) ? 0 : 1;
+}
+
+//
+// index for a piece
+//
+inline int
+pieceIndex(Piece piece) noexcept
+{
+  assert(not notPiece(piece));
+  return static_cast<int>(piece) - 1;
+}
+
+//
+// default ctor
+//
+inline
+BitBoard::BitBoard() noexcept
+  : mPieces(),
+    mColors() {}
+
+//
+// squares with a given piece and color
+//
+inline bitboard_t
+BitBoard::pieces(Color color, Piece piece) const noexcept
+{
+  return mPieces[colorIndex(color)][pieceIndex(piece)];
+}
+
+//
+// squares with a given piece of either color
+//
+inline bitboard_t
+BitBoard::pieces(Piece piece) const noexcept
+{
+  auto i = pieceIndex(piece);
+  return mPieces[0][i] | mPieces[1][i];
+}
+
+//
+// squares with a piece of a given color
+//
+inline bitboard_t
+BitBoard::color(Color color) const noexcept
+{
+  return mColors[colorIndex(color)];
+}
+
+//
+// squares with any piece
+//
+inline bitboard_t
+BitBoard::occupied() const noexcept
+{
+  return mColors[0] | mColors[1];
+}
+
+//
+// squares without a piece
+//
+inline bitboard_t
+BitBoard::empty() const noexcept
+{
+  return ~occupied();
+}
+
+//
+// add a piece to a square
+//
+inline void
+BitBoard::add(dim_t index, piece_t code) noexcept
+{
+  auto mask = squareMask(index);
+  auto c = colorIndex(getColor(code));
+  assert((occupied() & mask) == 0);
+  mPieces[c][pieceIndex(getPiece(code))] |= mask;
+  mColors[c] |= mask;
+}
+
+//
+// remove a piece from a square
+//
+inline void
+BitBoard::remove(dim_t index, piece_t code) noexcept
+{
+  auto mask = ~squareMask(index);
+  auto c = colorIndex(getColor(code));
+  mPieces[c][pieceIndex(getPiece(code))] &= mask;
+  mColors[c] &= mask;
+}
+
+//
+// equality operator
+//
+inline bool
+operator==(const BitBoard &bits1, const BitBoard &bits2) noexcept
+{
+  if (bits1.color(Color::W) != bits2.color(Color::W)
+      or bits1.color(Color::B) != bits2.color(Color::B))
+    return false;
+
+  for (auto color : {Color::W, Color::B}) {
+    for (auto piece : {Piece::P, Piece::N, Piece::B,
+                       Piece::R, Piece::Q, Piece::K}) {
+      if (bits1.pieces(color, piece) != bits2.pieces(color, piece))
+        return false;
+    }
+  }
+
+  return true;
+}
+
+//
+// non-equality operator
+//
+inline bool
+operator!=(const BitBoard &bits1, const BitBoard &bits2) noexcept
+{
+  return not (bits1 == bits2);
+}
+
+} // namespace zoor
+#endif // _BITBOARD_H
@@ -9,7 +9,7 @@
 //
 #include <algorithm>
 #include <cassert>
-#include <functional>
+#include <limits>
 #include <ostream>
 #include <sstream>
 #include <string>
@@ -19,12 +19,18 @@
 //
 // zoor
 //
+#include "attacks.hh"
 #include "basicboard.hh"
 #include "basictypes.hh"
+#include "bitboard.hh"
 #include "board.hh"
 #include "chesserror.hh"
+#include "movelist.hh"
 #include "piecemove.hh"
+#include "psqt.hh"
+#include "side.hh"
 #include "square.hh"
+#include "zobrist.hh"
 
 namespace zoor {
 
@@ -54,7 +60,11 @@ const jump_list Board::JUMP_KING = {
 // default ctor
 //
 Board::Board()
-  : mColor(Color::W) {}
+  : mColor(Color::W),
+    mHash(computeHash()),
+    mPsqt(computePsqt()),
+    mCheckers(0),
+    mAttacksValid(0) {}
 
 //
 // constructor with list of pieces
@@ -77,6 +87,10 @@ Board::Board(
 
   if (not isLastMoveOk())
     throw ChessError("Bad last move");
+
+  mHash = computeHash();
+  mPsqt = computePsqt();
+  updateChecks();
 }
 
 //
@@ -85,27 +99,35 @@ Board::Board(
 bool
 Board::canCastle() const noexcept
 {
-  dim_t row;
+  assert(not notColor(mColor));
+  return isWhite(mColor) ? canCastle<Color::W>() : canCastle<Color::B>();
+}
 
-  // set row to first or last
-  if (isWhite(mColor)) {
-    if (not mInfo.wkCastle())
-      return false;
-    row = 0;
-  } else {
-    if (not mInfo.bkCastle())
-      return false;
-    row = 7;
-  }
+//
+// check if king can do long castling
+//
+bool
+Board::canCastleLong() const noexcept
+{
+  assert(not notColor(mColor));
+  return isWhite(mColor) ? canCastleLong<Color::W>()
+                         : canCastleLong<Color::B>();
+}
 
-  // check that king is in castling position
-  auto piece = mBoard.get(row, 4);
-  if (not isKing(piece) or not isSame(piece, mColor))
+//
+// check if the king of a color can do short castling
+//
+template<Color C>
+bool
+Board::canCastle() const noexcept
+{
+  const dim_t row = Side<C>::FIRST_ROW;
+  if (not (isWhite(C) ? mInfo.wkCastle() : mInfo.bkCastle()))
     return false;
 
-  // check that rook is in castling position
-  piece = mBoard.get(row, 7);
-  if (not isRook(piece) or not isSame(piece, mColor))
+  // check that king and rook are in castling position
+  if (mBoard.get(row, 4) != (C | Piece::K)
+      or mBoard.get(row, 7) != (C | Piece::R))
     return false;
 
   // path for castling is clear
@@ -113,51 +135,37 @@ Board::canCastle() const noexcept
     return false;
 
   // no checks
-  if (isCheck(row, 4) or isCheck(row, 5) or isCheck(row, 6))
+  auto path = squareMask(row, 4) | squareMask(row, 5) | squareMask(row, 6);
+  if (attacks(Side<C>::THEM) & path)
     return false;
 
   return true;
 }
 
 //
-// check if king can do long castling
+// check if the king of a color can do long castling
 //
+template<Color C>
 bool
 Board::canCastleLong() const noexcept
 {
-  dim_t row;
-
-  // row and shift parameter for color
-  if (isWhite(mColor)) {
-    if (not mInfo.wkCastleLong())
-      return false;
-    row = 0;
-  } else {
-    if (not mInfo.bkCastleLong())
-      return false;
-    row = 7;
-  }
-
-  // check that king is in castling position
-  auto piece = mBoard.get(row, 4);
-  if (not isKing(piece) or not isSame(piece, mColor))
-    return false;
-
-  // check that rook is in castling position
-  piece = mBoard.get(row, 0);
-  if (not isRook(piece) or not isSame(piece, mColor))
+  const dim_t row = Side<C>::FIRST_ROW;
+  if (not (isWhite(C) ? mInfo.wkCastleLong() : mInfo.bkCastleLong()))
     return false;
 
-  // path for castling is clear
-  if (not notPiece(mBoard.get(row, 3)) or not notPiece(mBoard.get(row, 2)))
+  // check that king and rook are in castling position
+  if (mBoard.get(row, 4) != (C | Piece::K)
+      or mBoard.get(row, 0) != (C | Piece::R))
     return false;
 
-  // no checks on path to castle
-  if (isCheck(row, 3) or isCheck(row, 2))
+  // path for castling is clear, including the square next to the rook
+  if (not notPiece(mBoard.get(row, 3)) or not notPiece(mBoard.get(row, 2))
+      or not notPiece(mBoard.get(row, 1)))
     return false;
 
-  // not in check now
-  if (isCheck(row, 4))
+  // not in check now, and no checks on path to castle
+  auto path = squareMask(row, 4) | squareMask(row, 3) | squareMask(row, 2);
+  if (attacks(Side<C>::THEM) & path)
     return false;
 
   return true;
@@ -168,61 +176,642 @@ Board::canCastleLong() const noexcept
 //
 std::vector<PieceMove>
 Board::getMoves(dim_t row, dim_t column) const
+{
+  MoveList moveList;
+  getMoves(row, column, moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
+
+//
+// get all the moves from all the pieces
+//
+std::vector<PieceMove>
+Board::getMoves() const
+{
+  MoveList moveList;
+  getMoves(moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
+
+//
+// add the moves that can be made from a given square to a list
+//
+void
+Board::getMoves(dim_t row, dim_t column, MoveList &moveList) const noexcept
 {
   assert(not notColor(mColor));
-  std::vector<PieceMove> moveList;
 
   auto code = mBoard.get(row, column);
 
   if (notPiece(code) or not isSame(code, mColor))
-    return moveList;
+    return;
 
   switch (getPiece(code)) {
   case Piece::P:
-    moveList = movePawn(row, column);
+    movePawn(row, column, moveList);
     break;
   case Piece::N:
-    moveList = moveKnight(row, column);
+    moveKnight(row, column, moveList);
     break;
   case Piece::B:
-    moveList = moveBishop(row, column);
+    moveBishop(row, column, moveList);
     break;
   case Piece::R:
-    moveList = moveRook(row, column);
+    moveRook(row, column, moveList);
     break;
   case Piece::Q:
-    moveList = moveQueen(row, column);
+    moveQueen(row, column, moveList);
     break;
   case Piece::K:
-    moveList = moveKing(row, column);
+    moveKing(row, column, moveList);
     break;
   default:
     break;
   }
+}
+
+//
+// add the moves from all the pieces to a list
+//
+void
+Board::getMoves(MoveList &moveList) const noexcept
+{
+  assert(not notColor(mColor));
+  if (isWhite(mColor))
+    getMoves<Color::W>(moveList);
+  else
+    getMoves<Color::B>(moveList);
+}
 
-  return moveList;
+//
+// add the moves from all the pieces of a color to a list
+//
+template<Color C>
+void
+Board::getMoves(MoveList &moveList) const noexcept
+{
+  // squares are visited in the same order as the rows and columns
+  auto bits = mBoard.bits().color(C);
+  while (bits) {
+    auto index = popLsb(bits);
+    dim_t row = index / 8;
+    dim_t col = index % 8;
+
+    switch (getPiece(mBoard.get(row, col))) {
+    case Piece::P:
+      movePawn<C>(row, col, moveList);
+      break;
+    case Piece::N:
+      moveKnight(row, col, moveList);
+      break;
+    case Piece::B:
+      moveBishop(row, col, moveList);
+      break;
+    case Piece::R:
+      moveRook(row, col, moveList);
+      break;
+    case Piece::Q:
+      moveQueen(row, col, moveList);
+      break;
+    case Piece::K:
+      addMoves(row, col, C | Piece::K,
+               Attacks::king(index) & ~mBoard.bits().color(C), moveList);
+      addCastles<C>(moveList);
+      break;
+    default:
+      break;
+    }
+  }
 }
 
 //
-// get all the moves from all the pieces
+// get the legal moves
 //
 std::vector<PieceMove>
-Board::getMoves() const
+Board::getLegalMoves() const
+{
+  MoveList moveList;
+  getLegalMoves(moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
+
+//
+// add the legal moves to a list
+//
+void
+Board::getLegalMoves(MoveList &moveList, GenType type) const noexcept
+{
+  assert(not notColor(mColor));
+  if (isWhite(mColor))
+    getLegalMoves<Color::W>(moveList, type);
+  else
+    getLegalMoves<Color::B>(moveList, type);
+}
+
+//
+// add the legal moves of a color to a list
+//
+template<Color C>
+void
+Board::getLegalMoves(MoveList &moveList, GenType type) const noexcept
+{
+  const Color them = Side<C>::THEM;
+  auto &bits = mBoard.bits();
+  auto occupied = bits.occupied();
+  auto own = bits.color(C);
+
+  // the squares that the kind of move can go to, except for pawns, whose
+  // captures and promotions go to empty squares too
+  bitboard_t kind = ~own;
+  if (type == GenType::CAPTURES)
+    kind = bits.color(them);
+  else if (type == GenType::QUIETS)
+    kind = ~occupied;
+
+  // without a king, there are no checks
+  auto king = bits.pieces(C, Piece::K);
+  auto kingIndex = king ? lsbIndex(king) : 0;
+  bool doubleCheck = popCount(mCheckers) > 1;
+
+  // in check, the other pieces must capture the checking piece or block it
+  auto targets = ~own;
+  if (mCheckers)
+    targets = mCheckers | Attacks::between(kingIndex, lsbIndex(mCheckers));
+
+  auto pins = pinned();
+  auto pieces = own;
+  while (pieces) {
+    auto index = popLsb(pieces);
+    dim_t row = index / 8;
+    dim_t col = index % 8;
+    auto code = mBoard.get(row, col);
+
+    if (isKing(code)) {
+      auto kingTargets = Attacks::king(index) & kind;
+      if (king)
+        kingTargets &= ~attacks(them);
+      addMoves(row, col, code, kingTargets, moveList);
+      if (type != GenType::CAPTURES)
+        addCastles<C>(moveList);
+      continue;
+    }
+
+    if (doubleCheck)
+      continue;
+
+    // a pinned piece can only move along the line of the pin
+    auto allowed = targets;
+    if (pins & squareMask(index))
+      allowed &= Attacks::line(kingIndex, index);
+
+    switch (getPiece(code)) {
+    case Piece::P: {
+      // keep the pawn moves of the kind that go to an allowed square, and
+      // leave out the quiet moves if only captures are wanted
+      auto first = moveList.size();
+      if (type == GenType::CAPTURES)
+        addPawnCaptures<C>(row, col, moveList);
+      else
+        movePawn<C>(row, col, moveList);
+      auto last = first;
+      for (auto i = first; i < moveList.size(); ++i) {
+        auto &pm = moveList[i];
+        if (type != GenType::ALL
+            and (pm.isCapture() or pm.isPromo()) != (type == GenType::CAPTURES))
+          continue;
+        if (pm.isEnPassant() ? isEnPassantLegal(pm)
+            : allowed & squareMask(pm.dRow(), pm.dColumn()))
+          moveList[last++] = pm;
+      }
+      while (moveList.size() > last)
+        moveList.pop_back();
+      break;
+    }
+    case Piece::N:
+      allowed &= kind & Attacks::knight(index);
+      addMoves(row, col, code, allowed, moveList);
+      break;
+    case Piece::B:
+      allowed &= kind & Attacks::bishop(index, occupied);
+      addMoves(row, col, code, allowed, moveList);
+      break;
+    case Piece::R:
+      allowed &= kind & Attacks::rook(index, occupied);
+      addMoves(row, col, code, allowed, moveList);
+      break;
+    case Piece::Q:
+      allowed &= kind & Attacks::queen(index, occupied);
+      addMoves(row, col, code, allowed, moveList);
+      break;
+    default:
+      break;
+    }
+  }
+}
+
+//
+// is there a legal move
+//
+bool
+Board::hasLegalMove() const noexcept
+{
+  assert(not notColor(mColor));
+  return isWhite(mColor) ? countLegalMoves<Color::W>(1) > 0
+                         : countLegalMoves<Color::B>(1) > 0;
+}
+
+//
+// count the legal moves
+//
+int
+Board::countLegalMoves() const noexcept
+{
+  assert(not notColor(mColor));
+  const int limit = std::numeric_limits<int>::max();
+  return isWhite(mColor) ? countLegalMoves<Color::W>(limit)
+                         : countLegalMoves<Color::B>(limit);
+}
+
+//
+// count the legal moves of a color, up to a limit
+//
+template<Color C>
+int
+Board::countLegalMoves(int limit) const noexcept
+{
+  const Color them = Side<C>::THEM;
+  auto &bits = mBoard.bits();
+  auto occupied = bits.occupied();
+  auto own = bits.color(C);
+  int count = 0;
+
+  // the king first, since it is the only piece that can move in double check
+  auto king = bits.pieces(C, Piece::K);
+  auto kingIndex = king ? lsbIndex(king) : 0;
+  if (king) {
+    count += popCount(Attacks::king(kingIndex) & ~own & ~attacks(them));
+    count += canCastle<C>() + canCastleLong<C>();
+    if (count >= limit or popCount(mCheckers) > 1)
+      return count;
+  }
+
+  // in check, the other pieces must capture the checking piece or block it
+  auto targets = ~own;
+  if (mCheckers)
+    targets = mCheckers | Attacks::between(kingIndex, lsbIndex(mCheckers));
+
+  auto pins = pinned();
+  auto pieces = own & ~king;
+  while (pieces and count < limit) {
+    auto index = popLsb(pieces);
+
+    // a pinned piece can only move along the line of the pin
+    auto allowed = targets;
+    if (pins & squareMask(index))
+      allowed &= Attacks::line(kingIndex, index);
+
+    switch (getPiece(mBoard.get(index / 8, index % 8))) {
+    case Piece::P: {
+      dim_t row = index / 8;
+      dim_t col = index % 8;
+      assert(row != Side<C>::PROMO_ROW + Side<C>::FORWARD);
+      auto ahead = index + 8 * Side<C>::FORWARD;
+      auto moves = Attacks::pawn(C, index) & bits.color(them);
+      if (not (occupied & squareMask(ahead))) {
+        moves |= squareMask(ahead);
+        auto twoAhead = ahead + 8 * Side<C>::FORWARD;
+        if (row == Side<C>::PAWN_ROW and not (occupied & squareMask(twoAhead)))
+          moves |= squareMask(twoAhead);
+      }
+      // every move of a pawn about to promote counts once for each piece
+      count += popCount(moves & allowed) * (row == Side<C>::PROMO_ROW ? 4 : 1);
+
+      // en passant may leave the king in check through the emptied squares
+      auto epCol = enPassantColumn();
+      if (row == Side<C>::EN_PASSANT_ROW and epCol >= 0
+          and (epCol == col - 1 or epCol == col + 1)) {
+        PieceMove pm(row, col, C | Piece::P, row + Side<C>::FORWARD, epCol);
+        pm.xPiece(row, epCol, them | Piece::P);
+        count += isEnPassantLegal(pm);
+      }
+      break;
+    }
+    case Piece::N:
+      count += popCount(allowed & Attacks::knight(index));
+      break;
+    case Piece::B:
+      count += popCount(allowed & Attacks::bishop(index, occupied));
+      break;
+    case Piece::R:
+      count += popCount(allowed & Attacks::rook(index, occupied));
+      break;
+    case Piece::Q:
+      count += popCount(allowed & Attacks::queen(index, occupied));
+      break;
+    default:
+      break;
+    }
+  }
+
+  return count;
+}
+
+//
+// the pieces pinned to the king of the player to move
+//
+bitboard_t
+Board::pinned() const noexcept
+{
+  auto &bits = mBoard.bits();
+  auto king = bits.pieces(mColor, Piece::K);
+  if (not king)
+    return 0;
+
+  // the sliding pieces that would attack the king on an empty board
+  auto index = lsbIndex(king);
+  auto queens = bits.pieces(~mColor, Piece::Q);
+  auto diagonal = bits.pieces(~mColor, Piece::B) | queens;
+  auto straight = bits.pieces(~mColor, Piece::R) | queens;
+  auto snipers = (Attacks::bishop(index, 0) & diagonal)
+               | (Attacks::rook(index, 0) & straight);
+
+  // pinned if a single piece of the same color is in the way
+  auto occupied = bits.occupied();
+  bitboard_t pins = 0;
+  while (snipers) {
+    auto blockers = Attacks::between(index, popLsb(snipers)) & occupied;
+    if (popCount(blockers) == 1)
+      pins |= blockers & bits.color(mColor);
+  }
+
+  return pins;
+}
+
+//
+// check a move without generating the moves of the piece
+//
+bool
+Board::isPseudoLegal(const PieceMove &pMove) const noexcept
 {
   assert(not notColor(mColor));
+  return isWhite(mColor) ? isPseudoLegal<Color::W>(pMove)
+                         : isPseudoLegal<Color::B>(pMove);
+}
+
+//
+// check a move of a color without generating the moves of the piece
+//
+template<Color C>
+bool
+Board::isPseudoLegal(const PieceMove &pMove) const noexcept
+{
+  auto row = pMove.sRow();
+  auto column = pMove.sColumn();
+  auto toRow = pMove.dRow();
+  auto toCol = pMove.dColumn();
+  if (not BasicBoard::inBoard(row, column)
+      or not BasicBoard::inBoard(toRow, toCol))
+    return false;
+
+  // the piece is on its square, and its turn to move
+  auto fromCode = mBoard.get(row, column);
+  if (notPiece(fromCode) or not isSame(fromCode, C)
+      or fromCode != pMove.sCode())
+    return false;
 
-  std::vector<PieceMove> moveList;
+  // castling is encoded with the rook that moves
+  if (pMove.isCastle() or pMove.isCastleLong()) {
+    if (not (pMove.isCastle() ? canCastle<C>() : canCastleLong<C>()))
+      return false;
+    const dim_t cRow = Side<C>::FIRST_ROW;
+    PieceMove castle(cRow, 4, C | Piece::K, cRow, toCol);
+    castle.xPiece(cRow, pMove.isCastle() ? 7 : 0, Piece::R, C);
+    return castle == pMove;
+  }
+
+  auto toCode = mBoard.get(toRow, toCol);
+  if (not notPiece(toCode) and isSame(toCode, C))
+    return false;
 
-  for (dim_t row = 0; row < BasicBoard::DIM; ++row) {
-    for (dim_t col = 0; col < BasicBoard::DIM; ++col) {
-      if (isSame(mBoard.get(row, col), mColor)) {
-        auto moves = getMoves(row, col);
-        std::copy(moves.begin(), moves.end(), std::back_inserter(moveList));
+  auto from = squareIndex(row, column);
+  auto to = squareIndex(toRow, toCol);
+  auto occupied = mBoard.bits().occupied();
+  auto xRow = toRow;
+  bitboard_t targets = 0;
+
+  switch (getPiece(fromCode)) {
+  case Piece::P: {
+    const dim_t dir = Side<C>::FORWARD;
+    if (toCol == column) {
+      // straight ahead, one square, or two on the first move
+      if (not notPiece(toCode))
+        return false;
+      if (toRow != row + dir
+          and (row != Side<C>::PAWN_ROW or toRow != row + 2*dir
+               or not notPiece(mBoard.get(row + dir, column))))
+        return false;
+    } else if (Attacks::pawn(C, from) & squareMask(to)) {
+      // a capture, which is en passant if the square is empty, and the pawn
+      // is beside the pawn that just moved two squares
+      if (notPiece(toCode)) {
+        if (row != Side<C>::EN_PASSANT_ROW or not isEnPassant<C>(toCol))
+          return false;
+        xRow = row;
+        toCode = mBoard.get(row, toCol);
       }
+    } else
+      return false;
+
+    // a pawn that reaches the last row must be promoted
+    if (toRow == Side<C>::PROMO_ROW + dir) {
+      auto piece = pMove.dPiece();
+      if (piece != Piece::N and piece != Piece::B and piece != Piece::R
+          and piece != Piece::Q)
+        return false;
+      PieceMove promo(row, column, fromCode);
+      if (not notPiece(toCode))
+        promo.xPiece(toRow, toCol, toCode);
+      promo.dPiece(toRow, toCol, piece, C);
+      return promo == pMove;
+    }
+    targets = squareMask(to);
+    break;
+  }
+  case Piece::N:
+    targets = Attacks::knight(from);
+    break;
+  case Piece::B:
+    targets = Attacks::bishop(from, occupied);
+    break;
+  case Piece::R:
+    targets = Attacks::rook(from, occupied);
+    break;
+  case Piece::Q:
+    targets = Attacks::queen(from, occupied);
+    break;
+  case Piece::K:
+    targets = Attacks::king(from);
+    break;
+  default:
+    break;
+  }
+
+  if (not (targets & squareMask(to)))
+    return false;
+
+  // the move as the move generator encodes it
+  PieceMove expected(row, column, fromCode, toRow, toCol);
+  if (not notPiece(toCode))
+    expected.xPiece(xRow, toCol, toCode);
+  return expected == pMove;
+}
+
+//
+// check that a move is legal
+//
+bool
+Board::isLegal(const PieceMove &pMove) const noexcept
+{
+  if (not isPseudoLegal(pMove))
+    return false;
+
+  auto king = mBoard.bits().pieces(mColor, Piece::K);
+  if (not king)
+    return true;
+
+  // castling was verified against the attacks on its squares
+  if (pMove.isCastle() or pMove.isCastleLong())
+    return true;
+
+  auto to = squareMask(pMove.dRow(), pMove.dColumn());
+  if (isKing(pMove.sPiece()))
+    return not (attacks(~mColor) & to);
+
+  if (pMove.isEnPassant())
+    return isEnPassantLegal(pMove);
+
+  // in check, capture the checking piece or block the check
+  auto kingIndex = lsbIndex(king);
+  if (mCheckers) {
+    if (popCount(mCheckers) > 1)
+      return false;
+    auto block = Attacks::between(kingIndex, lsbIndex(mCheckers));
+    if (not ((mCheckers | block) & to))
+      return false;
+  }
+
+  // a pinned piece stays on the line of the pin
+  auto from = squareIndex(pMove.sRow(), pMove.sColumn());
+  if (pinned() & squareMask(from))
+    return Attacks::line(kingIndex, from) & to;
+
+  return true;
+}
+
+//
+// static exchange evaluation
+//
+int
+Board::see(const PieceMove &pMove) const noexcept
+{
+  if (pMove.isCastle() or pMove.isCastleLong())
+    return 0;
+
+  auto &bits = mBoard.bits();
+  auto to = squareIndex(pMove.dRow(), pMove.dColumn());
+  auto occupied = bits.occupied() ^ squareMask(pMove.sRow(), pMove.sColumn());
+  if (pMove.isEnPassant())
+    occupied ^= squareMask(pMove.xRow(), pMove.xColumn());
+
+  // the material won by each capture, less what the captures after it win
+  int gain[32];
+  int depth = 0;
+  gain[0] = pieceValue(pMove.xPiece());
+  auto onSquare = pMove.sPiece();
+  if (pMove.isPromo()) {
+    gain[0] += pieceValue(pMove.dPiece()) - pieceValue(Piece::P);
+    onSquare = pMove.dPiece();
+  }
+
+  auto color = ~pMove.sColor();
+  auto attackers = this->attackers(to, occupied) & occupied;
+  while (auto own = attackers & bits.color(color)) {
+    assert(depth < 31);
+    ++depth;
+    gain[depth] = pieceValue(onSquare) - gain[depth - 1];
+    onSquare = popLeastValuable(own, occupied);
+    attackers = this->attackers(to, occupied) & occupied;
+
+    // the king cannot capture a defended piece
+    if (isKing(onSquare) and (attackers & bits.color(~color))) {
+      --depth;
+      break;
     }
+    color = ~color;
+  }
+
+  // each player may stop capturing
+  while (depth--)
+    gain[depth] = -std::max(-gain[depth], gain[depth + 1]);
+  return gain[0];
+}
+
+//
+// static exchange evaluation against a threshold
+//
+bool
+Board::seeGE(const PieceMove &pMove, int threshold) const noexcept
+{
+  if (pMove.isCastle() or pMove.isCastleLong())
+    return 0 >= threshold;
+
+  auto captured = pieceValue(pMove.xPiece());
+  auto onSquare = pMove.sPiece();
+  if (pMove.isPromo()) {
+    captured += pieceValue(pMove.dPiece()) - pieceValue(Piece::P);
+    onSquare = pMove.dPiece();
+  }
+
+  // the balance if the move is not recaptured
+  int swap = captured - threshold;
+  if (swap < 0)
+    return false;
+
+  // the balance if the move is recaptured, and the recapture is not
+  swap = pieceValue(onSquare) - swap;
+  if (swap <= 0)
+    return true;
+
+  auto &bits = mBoard.bits();
+  auto to = squareIndex(pMove.dRow(), pMove.dColumn());
+  auto occupied = bits.occupied() ^ squareMask(pMove.sRow(), pMove.sColumn());
+  if (pMove.isEnPassant())
+    occupied ^= squareMask(pMove.xRow(), pMove.xColumn());
+
+  // true while the last player to capture reaches the threshold
+  bool result = true;
+  auto color = pMove.sColor();
+  auto attackers = this->attackers(to, occupied) & occupied;
+  while (true) {
+    color = ~color;
+    auto own = attackers & bits.color(color);
+    if (not own)
+      break;
+
+    result = not result;
+    auto piece = popLeastValuable(own, occupied);
+    attackers = this->attackers(to, occupied) & occupied;
+
+    // the king cannot capture a defended piece
+    if (isKing(piece))
+      return attackers & bits.color(~color) ? not result : result;
+
+    swap = pieceValue(piece) - swap;
+    if (swap < static_cast<int>(result))
+      break;
   }
 
-  return moveList;
+  return result;
 }
 
 //
@@ -232,7 +821,9 @@ std::vector<Board>
 Board::getBoards() const
 {
   std::vector<Board> boardList;
-  auto moveList = getMoves();
+  MoveList moveList;
+  getMoves(moveList);
+  boardList.reserve(moveList.size());
 
   // copy this board and make a move
   for (auto& pm : moveList) {
@@ -256,12 +847,8 @@ Board::makeMove(const PieceMove &pMove)
   // verify correct piece in square
   assert(isSame(pc, pMove.sPiece()) and isSame(pc, pMove.sColor()));
 
-  // fetch legal moves
-  auto moveList = getMoves(r, c);
-  auto it = std::find(moveList.begin(), moveList.end(), pMove);
-
   // throw error if move not legal
-  if (it == moveList.end())
+  if (not isPseudoLegal(pMove))
     throw ChessError("Illegal move");
 
   // make the move
@@ -270,6 +857,67 @@ Board::makeMove(const PieceMove &pMove)
   return *this;
 }
 
+//
+// make a move that can be taken back
+//
+Board&
+Board::makeMove(const PieceMove &pMove, MoveUndo &undo) noexcept
+{
+  undo.lastMove = mLastMove;
+  undo.info = mInfo;
+  undo.hash = mHash;
+  undo.psqt = mPsqt;
+  undo.checkers = mCheckers;
+
+  // the piece captured en passant is not on the destination square
+  if (pMove.isEnPassant())
+    undo.captured = mBoard.get(pMove.xRow(), pMove.xColumn());
+  else
+    undo.captured = mBoard.get(pMove.dRow(), pMove.dColumn());
+
+  return moveRef(pMove);
+}
+
+//
+// take back the last move
+//
+Board&
+Board::unmakeMove(const MoveUndo &undo) noexcept
+{
+  const auto &pMove = mLastMove;
+  auto color = ~mColor;
+  auto toRow = pMove.dRow();
+  auto toCol = pMove.dColumn();
+
+  // the hash and the piece-square sums are restored as a whole, so the squares
+  // are changed directly
+  mBoard.clear(toRow, toCol);
+  if (pMove.isCastle() or pMove.isCastleLong()) {
+    dim_t rookCol = pMove.isCastle() ? 5 : 3;
+    mBoard.clear(toRow, rookCol);
+    mBoard.put(pMove.xRow(), pMove.xColumn(), color | Piece::R);
+  }
+  mBoard.put(pMove.sRow(), pMove.sColumn(), color | pMove.sPiece());
+
+  // put back the captured piece
+  if (not notPiece(undo.captured)) {
+    if (pMove.isEnPassant())
+      mBoard.put(pMove.xRow(), pMove.xColumn(), undo.captured);
+    else
+      mBoard.put(toRow, toCol, undo.captured);
+  }
+
+  mColor = color;
+  mLastMove = undo.lastMove;
+  mInfo = undo.info;
+  mHash = undo.hash;
+  mPsqt = undo.psqt;
+  mCheckers = undo.checkers;
+  mAttacksValid = 0;
+
+  return *this;
+}
+
 //
 // check if the last move is valid, given the current position on the board
 //
@@ -284,46 +932,46 @@ Board::isLastMoveOk() const noexcept
 
     if (mLastMove.isCastle()) {
       if (isWhite(mLastMove.sColor())) {
-        auto pcode = mBoard.get(0, 7);
+        auto pcode = mBoard.get(0, 5);
         if (not isRook(pcode) or not isWhite(pcode))
           return false;
-        pcode = mBoard.get(0, 4);
+        pcode = mBoard.get(0, 6);
         if (not isKing(pcode) or not isWhite(pcode))
           return false;
-        // check if board info allows castling
-        if (not mInfo.wkCastle())
+        // check if board info knows the king moved
+        if (not mInfo.wkMoved())
           return false;
       } else {
-        auto pcode = mBoard.get(7, 7);
+        auto pcode = mBoard.get(7, 5);
         if (not isRook(pcode) or not isBlack(pcode))
           return false;
-        pcode = mBoard.get(7, 4);
+        pcode = mBoard.get(7, 6);
         if (not isKing(pcode) or not isBlack(pcode))
           return false;
-        // check if board info allows castling
-        if (not mInfo.bkCastle())
+        // check if board info knows the king moved
+        if (not mInfo.bkMoved())
           return false;
       }
     } else if (mLastMove.isCastleLong()) {
       if (isWhite(mLastMove.sColor())) {
-        auto pcode = mBoard.get(0, 0);
+        auto pcode = mBoard.get(0, 3);
         if (not isRook(pcode) or not isWhite(pcode))
           return false;
         pcode = mBoard.get(0, 2);
         if (not isKing(pcode) or not isWhite(pcode))
           return false;
-        // check if board info allows castling
-        if (not mInfo.wkCastleLong())
+        // check if board info knows the king moved
+        if (not mInfo.wkMoved())
           return false;
       } else {
-        auto pcode = mBoard.get(7, 0);
+        auto pcode = mBoard.get(7, 3);
         if (not isRook(pcode) or not isBlack(pcode))
           return false;
         pcode = mBoard.get(7, 2);
         if (not isKing(pcode) or not isBlack(pcode))
           return false;
-        // check if board info allows castling
-        if (not mInfo.bkCastleLong())
+        // check if board info knows the king moved
+        if (not mInfo.bkMoved())
           return false;
       }
     } else if (mLastMove.isPromo()) {
@@ -379,57 +1027,33 @@ Board::isCheckPawn(dim_t row, dim_t column) const noexcept
 {
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
-
-  if (isWhite(mColor)) {
-    auto toRow = row+1;
-    if (toRow < BasicBoard::DIM) {
-      if (column < BasicBoard::DIM-1) {
-        auto code = mBoard.get(toRow, column+1);
-        if (isPawn(code) and isBlack(code))
-          return true;
-      }
-      if (column > 0) {
-        auto code = mBoard.get(toRow, column-1);
-        if (isPawn(code) and isBlack(code))
-          return true;
-      }
-    }
-  } else {
-    auto toRow = row-1;
-    if (toRow >= 0) {
-      if (column < BasicBoard::DIM-1) {
-        auto code = mBoard.get(toRow, column+1);
-        if (isPawn(code) and isWhite(code))
-          return true;
-      }
-      if (column > 0) {
-        auto code = mBoard.get(toRow, column-1);
-        if (isPawn(code) and isWhite(code))
-          return true;
-      }
-    }
-  }
-
-  return false;
+  return isWhite(mColor) ? isCheckPawn<Color::W>(row, column)
+                         : isCheckPawn<Color::B>(row, column);
 }
 
 //
-// is there check from a knight
+// is it check from a pawn, on the king of a color
 //
+template<Color C>
 bool
-Board::isCheckKnight(dim_t row, dim_t column) const
+Board::isCheckPawn(dim_t row, dim_t column) const noexcept
+{
+  // a pawn of the other color checks from a square this side's pawn attacks
+  auto attacks = Attacks::pawn(C, squareIndex(row, column));
+  return attacks & mBoard.bits().pieces(Side<C>::THEM, Piece::P);
+}
+
+//
+// is there check from a knight
+//
+bool
+Board::isCheckKnight(dim_t row, dim_t column) const noexcept
 {
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
 
-  auto jumpList = jump(row, column, JUMP_KNIGHT);
-  for (auto& pos : jumpList) {
-    auto pcode = mBoard.get(pos.first, pos.second);
-    if (isKnight(pcode) and not isSame(pcode, mColor))
-      return true;
-  }
-
-  return false;
+  auto attacks = Attacks::knight(squareIndex(row, column));
+  return attacks & mBoard.bits().pieces(~mColor, Piece::N);
 }
 
 //
@@ -441,10 +1065,9 @@ Board::isCheckBishop(dim_t row, dim_t column) const noexcept
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
 
-  return isCheckNW(row, column, Piece::B)
-      or isCheckSW(row, column, Piece::B)
-      or isCheckNE(row, column, Piece::B)
-      or isCheckSE(row, column, Piece::B);
+  auto &bits = mBoard.bits();
+  auto attacks = Attacks::bishop(squareIndex(row, column), bits.occupied());
+  return attacks & bits.pieces(~mColor, Piece::B);
 }
 
 //
@@ -456,10 +1079,9 @@ Board::isCheckRook(dim_t row, dim_t column) const noexcept
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
 
-  return isCheckN(row, column, Piece::R)
-      or isCheckW(row, column, Piece::R)
-      or isCheckS(row, column, Piece::R)
-      or isCheckE(row, column, Piece::R);
+  auto &bits = mBoard.bits();
+  auto attacks = Attacks::rook(squareIndex(row, column), bits.occupied());
+  return attacks & bits.pieces(~mColor, Piece::R);
 }
 
 //
@@ -471,50 +1093,124 @@ Board::isCheckQueen(dim_t row, dim_t column) const noexcept
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
 
-  return isCheckN(row, column, Piece::Q)
-      or isCheckNE(row, column, Piece::Q)
-      or isCheckW(row, column, Piece::Q)
-      or isCheckSE(row, column, Piece::Q)
-      or isCheckS(row, column, Piece::Q)
-      or isCheckSW(row, column, Piece::Q)
-      or isCheckE(row, column, Piece::Q)
-      or isCheckNW(row, column, Piece::Q);
+  auto &bits = mBoard.bits();
+  auto attacks = Attacks::queen(squareIndex(row, column), bits.occupied());
+  return attacks & bits.pieces(~mColor, Piece::Q);
 }
 
 //
 // is there a check from the king
 //
 bool
-Board::isCheckKing(dim_t row, dim_t column) const
+Board::isCheckKing(dim_t row, dim_t column) const noexcept
 {
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
 
-  auto jumpList = jump(row, column, JUMP_KING);
-  for (auto& pos : jumpList) {
-    auto pcode = mBoard.get(pos.first, pos.second);
-    if (isKing(pcode) and not isSame(pcode, mColor))
-      return true;
-  }
-
-  return false;
+  auto attacks = Attacks::king(squareIndex(row, column));
+  return attacks & mBoard.bits().pieces(~mColor, Piece::K);
 }
 
 //
 // check if king is in danger
 //
 bool
-Board::isCheck(dim_t row, dim_t column) const
+Board::isCheck(dim_t row, dim_t column) const noexcept
 {
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
 
-  return isCheckRook(row, column)
-      or isCheckBishop(row, column)
-      or isCheckKing(row, column)
-      or isCheckQueen(row, column)
-      or isCheckPawn(row, column)
-      or isCheckKnight(row, column);
+  return isAttacked(row, column, ~mColor);
+}
+
+//
+// check if a square is attacked by pieces of a given color
+//
+bool
+Board::isAttacked(dim_t row, dim_t column, Color color) const noexcept
+{
+  assert(not notColor(color));
+  assert(BasicBoard::inBoard(row, column));
+
+  // a pawn attacks the square from a square that a pawn of the other color
+  // on the square would attack
+  auto &bits = mBoard.bits();
+  auto index = squareIndex(row, column);
+  if (Attacks::pawn(~color, index) & bits.pieces(color, Piece::P))
+    return true;
+  if (Attacks::knight(index) & bits.pieces(color, Piece::N))
+    return true;
+  if (Attacks::king(index) & bits.pieces(color, Piece::K))
+    return true;
+
+  // sliding pieces
+  auto occupied = bits.occupied();
+  auto queens = bits.pieces(color, Piece::Q);
+  auto diagonal = bits.pieces(color, Piece::B) | queens;
+  auto straight = bits.pieces(color, Piece::R) | queens;
+  return (Attacks::bishop(index, occupied) & diagonal)
+      or (Attacks::rook(index, occupied) & straight);
+}
+
+//
+// check if the king of a given color is attacked
+//
+bool
+Board::isKingAttacked(Color color) const noexcept
+{
+  if (color == mColor)
+    return mCheckers != 0;
+
+  auto king = mBoard.bits().pieces(color, Piece::K);
+  if (not king)
+    return false;
+
+  auto index = lsbIndex(king);
+  return isAttacked(index / 8, index % 8, ~color);
+}
+
+//
+// the squares attacked by a color
+//
+bitboard_t
+Board::attacks(Color color) const noexcept
+{
+  assert(not notColor(color));
+  auto ci = colorIndex(color);
+  if (mAttacksValid & (1 << ci))
+    return mAttacks[ci];
+
+  // the king of the other color does not block the sliding pieces
+  auto &bits = mBoard.bits();
+  auto occupied = bits.occupied() & ~bits.pieces(~color, Piece::K);
+  bitboard_t attacked = 0;
+
+  // visit the pieces of each kind, so that empty squares are never probed,
+  // and queens are visited as both bishops and rooks
+  auto pieces = bits.pieces(color, Piece::P);
+  while (pieces)
+    attacked |= Attacks::pawn(color, popLsb(pieces));
+
+  pieces = bits.pieces(color, Piece::N);
+  while (pieces)
+    attacked |= Attacks::knight(popLsb(pieces));
+
+  auto queens = bits.pieces(color, Piece::Q);
+  pieces = bits.pieces(color, Piece::B) | queens;
+  while (pieces)
+    attacked |= Attacks::bishop(popLsb(pieces), occupied);
+
+  pieces = bits.pieces(color, Piece::R) | queens;
+  while (pieces)
+    attacked |= Attacks::rook(popLsb(pieces), occupied);
+
+  pieces = bits.pieces(color, Piece::K);
+  while (pieces)
+    attacked |= Attacks::king(popLsb(pieces));
+
+  mAttacks[ci] = attacked;
+  mAttacksValid |= 1 << ci;
+  return attacked;
 }
 
 //
@@ -525,15 +1221,20 @@ Board::isEnPassant(Color color, dim_t toColumn) const noexcept
 {
   if (notColor(color))
     return false;
+  return isWhite(color) ? isEnPassant<Color::W>(toColumn)
+                        : isEnPassant<Color::B>(toColumn);
+}
 
-  dim_t toRow, fromRow;
-  if (isWhite(color)) {
-    toRow = 4;
-    fromRow = 6;
-  } else {
-    toRow = 3;
-    fromRow = 1;
-  }
+//
+// check if a pawn of a color can capture en passant at the given column
+//
+template<Color C>
+bool
+Board::isEnPassant(dim_t toColumn) const noexcept
+{
+  // the pawn that moved two squares is next to the pawn capturing it
+  const dim_t toRow = Side<C>::EN_PASSANT_ROW;
+  const dim_t fromRow = toRow + 2 * Side<C>::FORWARD;
 
   auto toCode = mBoard.get(toRow, toColumn);
   return isPawn(toCode) and not isSame(toCode, mColor)
@@ -547,33 +1248,34 @@ Board::isEnPassant(Color color, dim_t toColumn) const noexcept
 //
 // Return a list of all the pawn moves.
 //
-std::vector<PieceMove>
-Board::movePawn(dim_t row, dim_t column) const
+void
+Board::movePawn(dim_t row, dim_t column, MoveList &moveList) const noexcept
 {
   assert(not notColor(mColor));
+  if (isWhite(mColor))
+    movePawn<Color::W>(row, column, moveList);
+  else
+    movePawn<Color::B>(row, column, moveList);
+}
+
+//
+// add the moves of a pawn of a color to a list
+//
+template<Color C>
+void
+Board::movePawn(dim_t row, dim_t column, MoveList &moveList) const noexcept
+{
   assert(BasicBoard::inBoard(row, column));
   auto fromCode = mBoard.get(row, column);
   assert(isPawn(fromCode));
 
-  std::vector<PieceMove> moveList;
-  dim_t cmpRow;
-  std::function<bool(dim_t, dim_t)> cmpFunc;
-  std::function<dim_t(dim_t, dim_t)> rowOp;
-
-  // set handles to deal with black or white pawn move
-  if (isWhite(mColor)) {
-    cmpRow = 6;
-    cmpFunc = std::less<dim_t>();
-    rowOp = std::plus<dim_t>();
-  } else {
-    cmpRow = 1;
-    cmpFunc = std::greater<dim_t>();
-    rowOp = std::minus<dim_t>();
-  }
+  // the direction of the pawn, and the rows where its moves change
+  const dim_t dir = Side<C>::FORWARD;
+  const dim_t promoRow = Side<C>::PROMO_ROW;
 
   // all normal moves (i.e., pawn moves one square up or down)
-  if (cmpFunc(row, cmpRow)) {
-    auto toRow = rowOp(row, 1);
+  if (isWhite(C) ? row < promoRow : row > promoRow) {
+    auto toRow = row + dir;
     // check one square straight up or down
     auto toCode = mBoard.get(toRow, column);
     if (notPiece(toCode))
@@ -582,7 +1284,7 @@ Board::movePawn(dim_t row, dim_t column) const
     if (column > 0) {
       auto toCol = column-1;
       toCode = mBoard.get(toRow, toCol);
-      if (not notPiece(toCode) and not isSame(toCode, mColor)) {
+      if (not notPiece(toCode) and not isSame(toCode, C)) {
         moveList.emplace_back(row, column, fromCode, toRow, toCol);
         moveList.back().xPiece(toRow, toCol, toCode);
       }
@@ -591,74 +1293,65 @@ Board::movePawn(dim_t row, dim_t column) const
     if (column < 7) {
       auto toCol = column+1;
       toCode = mBoard.get(toRow, toCol);
-      if (not notPiece(toCode) and not isSame(toCode, mColor)) {
+      if (not notPiece(toCode) and not isSame(toCode, C)) {
         moveList.emplace_back(row, column, fromCode, toRow, toCol);
         moveList.back().xPiece(toRow, toCol, toCode);
       }
     }
   }
 
-  // set comparison row for first pawn move
-  cmpRow = isWhite(mColor) ? 1 : 6;
-
   // two moves on first move
-  if (row == cmpRow) {
-    if (notPiece(mBoard.get(rowOp(row, 1), column))) {
-      auto toRow = rowOp(row, 2);
+  if (row == Side<C>::PAWN_ROW) {
+    if (notPiece(mBoard.get(row + dir, column))) {
+      auto toRow = row + 2*dir;
       if (notPiece(mBoard.get(toRow, column)))
         moveList.emplace_back(row, column, fromCode, toRow, column);
     }
   }
 
-  // set comparison row for en passant
-  cmpRow = isWhite(mColor) ? 4 : 3;
-
   // en passant
-  if (row == cmpRow) {
+  if (row == Side<C>::EN_PASSANT_ROW) {
     // checking column to the left
     if (column > 0) {
       auto toCol = column-1;
-      if (isEnPassant(mColor, toCol)) {
-        moveList.emplace_back(row, column, fromCode, rowOp(row, 1), toCol);
+      if (isEnPassant<C>(toCol)) {
+        moveList.emplace_back(row, column, fromCode, row + dir, toCol);
         moveList.back().xPiece(row, toCol, mBoard.get(row, toCol));
       }
     }
     // checking column to the right
     if (column < 7) {
       auto toCol = column+1;
-      if (isEnPassant(mColor, toCol)) {
-        moveList.emplace_back(row, column, fromCode, rowOp(row, 1), toCol);
+      if (isEnPassant<C>(toCol)) {
+        moveList.emplace_back(row, column, fromCode, row + dir, toCol);
         moveList.back().xPiece(row, toCol, mBoard.get(row, toCol));
       }
     }
   }
 
-  // set comparison row for promotion
-  cmpRow = isWhite(mColor) ? 6 : 1;
-
   // pawn promotion
-  if (row == cmpRow) {
+  if (row == promoRow) {
     Piece pcArr[] = {
       Piece::N, Piece::B, Piece::R, Piece::Q
     };
-    auto toRow = rowOp(row, 1);
+    auto toRow = row + dir;
     // check one square up
     auto toCode = mBoard.get(toRow, column);
     if (notPiece(toCode)) {
       for (auto& pc : pcArr) {
         moveList.emplace_back(row, column, fromCode);
-        moveList.back().dPiece(toRow, column, pc, mColor);
+        moveList.back().dPiece(toRow, column, pc, C);
       }
     }
     // check diagonal square to the left
     if (column > 0) {
       auto toCol = column-1;
       toCode = mBoard.get(toRow, toCol);
-      if (not notPiece(toCode) and not isSame(toCode, mColor)) {
+      if (not notPiece(toCode) and not isSame(toCode, C)) {
         for (auto& pc : pcArr) {
           moveList.emplace_back(row, column, fromCode);
           moveList.back().xPiece(toRow, toCol, toCode);
-          moveList.back().dPiece(toRow, toCol, pc, mColor);
+          moveList.back().dPiece(toRow, toCol, pc, C);
         }
       }
     }
@@ -666,388 +1359,244 @@ Board::movePawn(dim_t row, dim_t column) const
     if (column < 7) {
       auto toCol = column+1;
       toCode = mBoard.get(toRow, toCol);
-      if (not notPiece(toCode) and not isSame(toCode, mColor)) {
+      if (not notPiece(toCode) and not isSame(toCode, C)) {
         for (auto& pc : pcArr) {
           moveList.emplace_back(row, column, fromCode);
           moveList.back().xPiece(toRow, toCol, toCode);
-          moveList.back().dPiece(toRow, toCol, pc, mColor);
+          moveList.back().dPiece(toRow, toCol, pc, C);
         }
       }
     }
   }
 
-  return moveList;
 }
 
 //
 // move knight
 //
-std::vector<PieceMove>
-Board::moveKnight(dim_t row, dim_t column) const
+void
+Board::moveKnight(dim_t row, dim_t column, MoveList &moveList) const noexcept
 {
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
   auto fromCode = mBoard.get(row, column);
   assert(isKnight(fromCode));
-  std::vector<PieceMove> moveList;
 
-  auto jumpList = jump(row, column, JUMP_KNIGHT);
-  for (auto &pos : jumpList) {
-    auto toCode = mBoard.get(pos.first, pos.second);
-    if (notPiece(toCode))
-      moveList.emplace_back(row, column, fromCode, pos.first, pos.second);
-    else if (not isSame(toCode, mColor)) {
-      moveList.emplace_back(row, column, fromCode, pos.first, pos.second);
-      moveList.back().xPiece(pos.first, pos.second, toCode);
-    }
-  }
+  auto targets = Attacks::knight(squareIndex(row, column))
+               & ~mBoard.bits().color(mColor);
+  addMoves(row, column, fromCode, targets, moveList);
+}
 
-  return moveList;
+//
+// moves to each target square, capturing the piece on it, if any
+//
+void
+Board::addMoves(dim_t row, dim_t column, piece_t fromCode, bitboard_t targets,
+                 MoveList &moveList) const noexcept
+{
+  while (targets) {
+    auto index = popLsb(targets);
+    dim_t toRow = index / BasicBoard::DIM;
+    dim_t toCol = index % BasicBoard::DIM;
+    auto toCode = mBoard.get(toRow, toCol);
+    moveList.emplace_back(row, column, fromCode, toRow, toCol);
+    if (not notPiece(toCode))
+      moveList.back().xPiece(toRow, toCol, toCode);
+  }
 }
 
 //
-// move bishop
+// the pawn moves that change the material on the board
 //
-std::vector<PieceMove>
-Board::moveBishop(dim_t row, dim_t column) const
+template<Color C>
+void
+Board::addPawnCaptures(dim_t row, dim_t column, MoveList &moveList)
+  const noexcept
 {
-  assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
   auto fromCode = mBoard.get(row, column);
-  assert(isBishop(fromCode));
-  std::vector<PieceMove> moveList;
+  assert(isPawn(fromCode));
 
-  // check all moves right and up
-  for (auto toCol = column+1, toRow = row+1;
-       toCol < BasicBoard::DIM and toRow < BasicBoard::DIM; ++toCol, ++toRow) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-      moveList.back().xPiece(toRow, toCol, toCode);
-      break;
-    }
-  }
+  auto toRow = row + Side<C>::FORWARD;
+  auto targets = Attacks::pawn(C, squareIndex(row, column))
+               & mBoard.bits().color(Side<C>::THEM);
 
-  // check all moves right and down
-  for (auto toCol = column+1, toRow = row-1;
-       toCol < BasicBoard::DIM and toRow >= 0; ++toCol, --toRow) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-      moveList.back().xPiece(toRow, toCol, toCode);
-      break;
+  // before the last row, every move is a promotion
+  if (row == Side<C>::PROMO_ROW) {
+    if (notPiece(mBoard.get(toRow, column)))
+      targets |= squareMask(toRow, column);
+    Piece pcArr[] = {
+      Piece::N, Piece::B, Piece::R, Piece::Q
+    };
+    while (targets) {
+      auto toCol = popLsb(targets) % BasicBoard::DIM;
+      auto toCode = mBoard.get(toRow, toCol);
+      for (auto& pc : pcArr) {
+        moveList.emplace_back(row, column, fromCode);
+        if (not notPiece(toCode))
+          moveList.back().xPiece(toRow, toCol, toCode);
+        moveList.back().dPiece(toRow, toCol, pc, C);
+      }
     }
+    return;
   }
 
-  // check all moves left and up
-  for (auto toCol = column-1, toRow = row+1;
-       toCol >= 0 and toRow < BasicBoard::DIM; --toCol, ++toRow) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-      moveList.back().xPiece(toRow, toCol, toCode);
-      break;
-    }
-  }
+  addMoves(row, column, fromCode, targets, moveList);
 
-  // check all moves left and down
-  for (auto toCol = column-1, toRow = row-1;
-       toCol >= 0 and toRow >= 0; --toCol, --toRow) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-    else {
+  // en passant
+  if (row == Side<C>::EN_PASSANT_ROW) {
+    auto toCol = enPassantColumn();
+    if (toCol >= 0 and (toCol == column - 1 or toCol == column + 1)) {
       moveList.emplace_back(row, column, fromCode, toRow, toCol);
-      moveList.back().xPiece(toRow, toCol, toCode);
-      break;
+      moveList.back().xPiece(row, toCol, mBoard.get(row, toCol));
     }
   }
+}
 
-  return moveList;
+//
+// move bishop
+//
+void
+Board::moveBishop(dim_t row, dim_t column, MoveList &moveList) const noexcept
+{
+  assert(not notColor(mColor));
+  assert(BasicBoard::inBoard(row, column));
+  auto fromCode = mBoard.get(row, column);
+  assert(isBishop(fromCode));
+
+  auto &bits = mBoard.bits();
+  auto targets = Attacks::bishop(squareIndex(row, column), bits.occupied())
+               & ~bits.color(mColor);
+  addMoves(row, column, fromCode, targets, moveList);
 }
 
 //
 // move rook
 //
-std::vector<PieceMove>
-Board::moveRook(dim_t row, dim_t column) const
+void
+Board::moveRook(dim_t row, dim_t column, MoveList &moveList) const noexcept
 {
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
   auto fromCode = mBoard.get(row, column);
   assert(isRook(fromCode));
-  std::vector<PieceMove> moveList;
-
-  // check all moves right
-  for (auto toCol = column+1; toCol < BasicBoard::DIM; ++toCol) {
-    auto toCode = mBoard.get(row, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, row, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, row, toCol);
-      moveList.back().xPiece(row, toCol, toCode);
-      break;
-    }
-  }
-
-  // check all moves left
-  for (auto toCol = column-1; toCol >= 0; --toCol) {
-    auto toCode = mBoard.get(row, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, row, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, row, toCol);
-      moveList.back().xPiece(row, toCol, toCode);
-      break;
-    }
-  }
-
-  // check all moves up
-  for (auto toRow = row+1; toRow < BasicBoard::DIM; ++toRow) {
-    auto toCode = mBoard.get(toRow, column);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, column);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, column);
-      moveList.back().xPiece(toRow, column, toCode);
-      break;
-    }
-  }
-
-  // check all moves down
-  for (auto toRow = row-1; toRow >= 0; --toRow) {
-    auto toCode = mBoard.get(toRow, column);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, column);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, column);
-      moveList.back().xPiece(toRow, column, toCode);
-      break;
-    }
-  }
 
-  return moveList;
+  auto &bits = mBoard.bits();
+  auto targets = Attacks::rook(squareIndex(row, column), bits.occupied())
+               & ~bits.color(mColor);
+  addMoves(row, column, fromCode, targets, moveList);
 }
 
 //
 // move queen
 //
-std::vector<PieceMove>
-Board::moveQueen(dim_t row, dim_t column) const
+void
+Board::moveQueen(dim_t row, dim_t column, MoveList &moveList) const noexcept
 {
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
   auto fromCode = mBoard.get(row, column);
   assert(isQueen(fromCode));
-  std::vector<PieceMove> moveList;
-
-  // check all moves right
-  for (auto toCol = column+1; toCol < BasicBoard::DIM; ++toCol) {
-    auto toCode = mBoard.get(row, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, row, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, row, toCol);
-      moveList.back().xPiece(row, toCol, toCode);
-      break;
-    }
-  }
-
-  // check all moves left
-  for (auto toCol = column-1; toCol >= 0; --toCol) {
-    auto toCode = mBoard.get(row, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, row, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, row, toCol);
-      moveList.back().xPiece(row, toCol, toCode);
-      break;
-    }
-  }
-
-  // check all moves up
-  for (auto toRow = row+1; toRow < BasicBoard::DIM; ++toRow) {
-    auto toCode = mBoard.get(toRow, column);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, column);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, column);
-      moveList.back().xPiece(toRow, column, toCode);
-      break;
-    }
-  }
-
-  // check all moves down
-  for (auto toRow = row-1; toRow >= 0; --toRow) {
-    auto toCode = mBoard.get(toRow, column);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, column);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, column);
-      moveList.back().xPiece(toRow, column, toCode);
-      break;
-    }
-  }
-
-  // check all moves right and up
-  for (auto toCol = column+1, toRow = row+1;
-       toCol < BasicBoard::DIM and toRow < BasicBoard::DIM; ++toCol, ++toRow) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-      moveList.back().xPiece(toRow, toCol, toCode);
-      break;
-    }
-  }
-
-  // check all moves right and down
-  for (auto toCol = column+1, toRow = row-1;
-       toCol < BasicBoard::DIM and toRow >= 0; ++toCol, --toRow) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-      moveList.back().xPiece(toRow, toCol, toCode);
-      break;
-    }
-  }
-
-  // check all moves left and up
-  for (auto toCol = column-1, toRow = row+1;
-       toCol >= 0 and toRow < BasicBoard::DIM; --toCol, ++toRow) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-      moveList.back().xPiece(toRow, toCol, toCode);
-      break;
-    }
-  }
-
-  // check all moves left and down
-  for (auto toCol = column-1, toRow = row-1;
-       toCol >= 0 and toRow >= 0; --toCol, --toRow) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (isSame(toCode, mColor))
-      break;
-    else if (notColor(toCode))
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-    else {
-      moveList.emplace_back(row, column, fromCode, toRow, toCol);
-      moveList.back().xPiece(toRow, toCol, toCode);
-      break;
-    }
-  }
 
-  return moveList;
+  auto &bits = mBoard.bits();
+  auto targets = Attacks::queen(squareIndex(row, column), bits.occupied())
+               & ~bits.color(mColor);
+  addMoves(row, column, fromCode, targets, moveList);
 }
 
 //
 // move king
 //
-std::vector<PieceMove>
-Board::moveKing(dim_t row, dim_t column) const
+void
+Board::moveKing(dim_t row, dim_t column, MoveList &moveList) const noexcept
 {
   assert(not notColor(mColor));
   assert(BasicBoard::inBoard(row, column));
   auto fromCode = mBoard.get(row, column);
   assert(isKing(fromCode));
-  std::vector<PieceMove> moveList;
 
   // normal moves
-  auto jumpList = jump(row, column, JUMP_KING);
-  for (auto& pos : jumpList) {
-    auto toCode = mBoard.get(pos.first, pos.second);
-    if (notPiece(toCode))
-      moveList.emplace_back(row, column, fromCode, pos.first, pos.second);
-    else if (not isSame(toCode, mColor)) {
-      moveList.emplace_back(row, column, fromCode, pos.first, pos.second);
-      moveList.back().xPiece(pos.first, pos.second, toCode);
-    }
-  }
+  auto targets = Attacks::king(squareIndex(row, column))
+               & ~mBoard.bits().color(mColor);
+  addMoves(row, column, fromCode, targets, moveList);
 
-  // short castling
-  if (canCastle()) {
-    auto cRow = isWhite(mColor) ? 0 : 7;
-    moveList.emplace_back(cRow, 4, mColor | Piece::K, cRow, 6);
-    moveList.back().xPiece(cRow, 7, Piece::R, mColor);
-  }
-
-  // long castling
-  if (canCastleLong()) {
-    auto cRow = isWhite(mColor) ? 0 : 7;
-    moveList.emplace_back(cRow, 4, mColor | Piece::K, cRow, 2);
-    moveList.back().xPiece(cRow, 0, Piece::R, mColor);
-  }
-
-  return moveList;
+  addCastles(moveList);
 }
 
 //
-// return a hash code of the board using One-at-a-Time hash
+// vector versions of the moves of each piece
 //
-size_t
-Board::hashCode() const noexcept
+std::vector<PieceMove>
+Board::movePawn(dim_t row, dim_t column) const
 {
-  size_t h = 0;
+  MoveList moveList;
+  movePawn(row, column, moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
 
-  // hash the contents of board
-  for (auto &piece : mBoard) {
-    h += static_cast<size_t>(piece);
-    h += h << 10;
-    h ^= h >> 6;
-  }
+std::vector<PieceMove>
+Board::moveKnight(dim_t row, dim_t column) const
+{
+  MoveList moveList;
+  moveKnight(row, column, moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
 
-  // hash the turn to move of white or black
-  h += static_cast<size_t>(mColor);
-  h += h << 10;
-  h ^= h >> 6;
+std::vector<PieceMove>
+Board::moveBishop(dim_t row, dim_t column) const
+{
+  MoveList moveList;
+  moveBishop(row, column, moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
 
-  h += h << 3;
-  h += h >> 11;
-  h += h << 15;
+std::vector<PieceMove>
+Board::moveRook(dim_t row, dim_t column) const
+{
+  MoveList moveList;
+  moveRook(row, column, moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
 
-  return h;
+std::vector<PieceMove>
+Board::moveQueen(dim_t row, dim_t column) const
+{
+  MoveList moveList;
+  moveQueen(row, column, moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
+
+std::vector<PieceMove>
+Board::moveKing(dim_t row, dim_t column) const
+{
+  MoveList moveList;
+  moveKing(row, column, moveList);
+  return std::vector<PieceMove>(moveList.begin(), moveList.end());
+}
+
+//
+// column where en passant is possible
+//
+dim_t
+Board::enPassantColumn() const noexcept
+{
+  if (not isPawn(mLastMove.sPiece()))
+    return -1;
+
+  auto fromRow = mLastMove.sRow();
+  auto toRow = mLastMove.dRow();
+  if (fromRow - toRow != 2 and toRow - fromRow != 2)
+    return -1;
+
+  // only counts if a pawn can make the capture
+  auto col = mLastMove.dColumn();
+  auto pawn = mColor | Piece::P;
+  if (col > 0 and mBoard.get(toRow, col-1) == pawn)
+    return col;
+  if (col < BasicBoard::DIM-1 and mBoard.get(toRow, col+1) == pawn)
+    return col;
+
+  return -1;
 }
 
 //
@@ -1060,12 +1609,16 @@ Board::moveRef(const PieceMove &pMove) noexcept
   auto toRow = pMove.dRow();
   auto toCol = pMove.dColumn();
 
+  // remove the keys for the castling rights and en passant before the move
+  mHash ^= Zobrist::castle(mInfo.castleBits());
+  mHash ^= Zobrist::enPassant(enPassantColumn());
+
   // clear piece from where it is moving
-  mBoard.clear(pMove.sRow(), pMove.sColumn());
+  clearPiece(pMove.sRow(), pMove.sColumn());
 
   // clear captured piece
   if (pMove.isCapture()) {
-    mBoard.clear(pMove.xRow(), pMove.xColumn());
+    clearPiece(pMove.xRow(), pMove.xColumn());
     // check if it is mate
     if (isKing(pMove.xPiece())) {
       if (isWhite(pMove.xColor()))
@@ -1073,55 +1626,35 @@ Board::moveRef(const PieceMove &pMove) noexcept
       else
         mInfo.bkMateOn();
     }
+    // a rook captured in its corner can no longer castle
+    if (isRook(pMove.xPiece()))
+      rookMoved(pMove.xRow(), pMove.xColumn());
   }
 
   auto piece = pMove.sPiece();
   if (isPawn(piece)) {
     auto piece = pMove.isPromo() ? pMove.dPiece() : Piece::P;
-    mBoard.put(toRow, toCol, piece, mColor);
+    putPiece(toRow, toCol, mColor | piece);
   } else if (isKing(piece)) {
+    // a king that moves can no longer castle
+    if (isWhite(mColor))
+      mInfo.wkMovedOn();
+    else
+      mInfo.bkMovedOn();
     if (pMove.isCastle() or pMove.isCastleLong()) {
-      if (isWhite(mColor)) {
-        mInfo.rookH1On();
-        mInfo.wkMovedOn();
-      } else {
-        mInfo.rookH8On();
-        mInfo.bkMovedOn();
-      }
+      rookMoved(pMove.xRow(), pMove.xColumn());
       // clear the rook from corner square
-      mBoard.clear(pMove.xRow(), pMove.xColumn());
-      mBoard.put(toRow, toCol, Piece::K, mColor);
+      clearPiece(pMove.xRow(), pMove.xColumn());
+      putPiece(toRow, toCol, mColor | Piece::K);
       dim_t rookCol = pMove.isCastle() ? 5 : 3;
-      mBoard.put(toRow, rookCol, Piece::R, mColor);
+      putPiece(toRow, rookCol, mColor | Piece::R);
     } else
-      mBoard.put(toRow, toCol, Piece::K, mColor);
+      putPiece(toRow, toCol, mColor | Piece::K);
   } else {
-    mBoard.put(toRow, toCol, piece, mColor);
+    putPiece(toRow, toCol, mColor | piece);
     // set flag if a rook has moved
-    if (isRook(piece)) {
-      auto row = pMove.sRow();
-      auto col = pMove.sColumn();
-      if (isWhite(mColor)) {
-        if (not mInfo.rookH1() and row == 0 and col == 7)
-          mInfo.rookH1On();
-        else if (not mInfo.rookA1() and row == 0 and col == 0)
-          mInfo.rookA1On();
-      } else {
-        if (not mInfo.rookH8() and row == 7 and col == 7)
-          mInfo.rookH8On();
-        else if (not mInfo.rookH1() and row == 7 and col == 0)
-          mInfo.rookH1On();
-      }
-    }
-  }
-
-  // if there was a check, but not any more, remove it
-  if (isWhite(mColor) ) {
-    if (mInfo.wkCheck() and not isCheck(toRow, toCol))
-      mInfo.wkCheckSet(false);
-  } else {
-    if (mInfo.bkCheck() and not isCheck(toRow, toCol))
-      mInfo.bkCheckSet(false);
+    if (isRook(piece))
+      rookMoved(pMove.sRow(), pMove.sColumn());
   }
 
   // update the last move
@@ -1130,191 +1663,242 @@ Board::moveRef(const PieceMove &pMove) noexcept
   // flip the color
   mColor = ~mColor;
 
+  // add the keys for the side to move, castling rights, and en passant
+  mHash ^= Zobrist::side();
+  mHash ^= Zobrist::castle(mInfo.castleBits());
+  mHash ^= Zobrist::enPassant(enPassantColumn());
+
+  updateChecks();
+
   return *this;
 }
 
 //
-// is there a check in the diagonal from above and to the right
+// set the flag for a rook that moves from, or is captured in, its corner
 //
-bool
-Board::isCheckNE(dim_t row, dim_t column, Piece piece) const noexcept
+void
+Board::rookMoved(dim_t row, dim_t column) noexcept
 {
-  assert(not notColor(mColor));
-  assert(BasicBoard::inBoard(row, column));
+  if (row == 0 and column == 0)
+    mInfo.rookA1On();
+  else if (row == 0 and column == 7)
+    mInfo.rookH1On();
+  else if (row == 7 and column == 0)
+    mInfo.rookA8On();
+  else if (row == 7 and column == 7)
+    mInfo.rookH8On();
+}
 
-  for (auto toRow = row+1, toCol = column+1;
-       toRow < BasicBoard::DIM and toCol < BasicBoard::DIM; ++toRow, ++toCol) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (notColor(toCode))
-      continue;
-    else if (isSame(toCode, mColor) or not isSame(toCode, piece))
-      break;
-    else
-      return true;
-  }
+//
+// put a piece on a square and update the hash and piece-square sums
+//
+void
+Board::putPiece(dim_t row, dim_t column, piece_t code) noexcept
+{
+  clearPiece(row, column);
+  mBoard.put(row, column, code);
+  auto index = squareIndex(row, column);
+  mHash ^= Zobrist::piece(code, index);
+  mPsqt.add(code, index);
+}
 
-  return false;
+//
+// remove a piece from a square and update the hash and piece-square sums
+//
+void
+Board::clearPiece(dim_t row, dim_t column) noexcept
+{
+  auto code = mBoard.get(row, column);
+  if (notPiece(code))
+    return;
+  mBoard.clear(row, column);
+  auto index = squareIndex(row, column);
+  mHash ^= Zobrist::piece(code, index);
+  mPsqt.remove(code, index);
 }
 
 //
-// is there a check in the diagonal from below and to the right
+// add the castling moves
 //
-bool
-Board::isCheckSE(dim_t row, dim_t column, Piece piece) const noexcept
+void
+Board::addCastles(MoveList &moveList) const noexcept
 {
   assert(not notColor(mColor));
-  assert(BasicBoard::inBoard(row, column));
-
-  for (auto toRow = row-1, toCol = column+1;
-       toRow >= 0 and toCol < BasicBoard::DIM; --toRow, ++toCol) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (notColor(toCode))
-      continue;
-    else if (isSame(toCode, mColor) or not isSame(toCode, piece))
-      break;
-    else
-      return true;
-  }
-
-  return false;
+  if (isWhite(mColor))
+    addCastles<Color::W>(moveList);
+  else
+    addCastles<Color::B>(moveList);
 }
 
 //
-// is there a check in the diagonal from below and to the left
+// add the castling moves of a color
 //
-bool
-Board::isCheckSW(dim_t row, dim_t column, Piece piece) const noexcept
+template<Color C>
+void
+Board::addCastles(MoveList &moveList) const noexcept
 {
-  assert(not notColor(mColor));
-  assert(BasicBoard::inBoard(row, column));
+  const dim_t cRow = Side<C>::FIRST_ROW;
 
-  for (auto toRow = row-1, toCol = column-1;
-       toRow >= 0 and toCol >= 0; --toRow, --toCol) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (notColor(toCode))
-      continue;
-    else if (isSame(toCode, mColor) or not isSame(toCode, piece))
-      break;
-    else
-      return true;
+  // short castling
+  if (canCastle<C>()) {
+    moveList.emplace_back(cRow, 4, C | Piece::K, cRow, 6);
+    moveList.back().xPiece(cRow, 7, Piece::R, C);
   }
 
-  return false;
+  // long castling
+  if (canCastleLong<C>()) {
+    moveList.emplace_back(cRow, 4, C | Piece::K, cRow, 2);
+    moveList.back().xPiece(cRow, 0, Piece::R, C);
+  }
 }
 
 //
-// is there a check in the diagonal from above and to the left
+// check that an en passant capture does not leave the king in check
 //
 bool
-Board::isCheckNW(dim_t row, dim_t column, Piece piece) const noexcept
+Board::isEnPassantLegal(const PieceMove &pMove) const noexcept
 {
-  assert(not notColor(mColor));
-  assert(BasicBoard::inBoard(row, column));
-
-  for (auto toRow = row+1, toCol = column-1;
-       toRow < BasicBoard::DIM and toCol >= 0; ++toRow, --toCol) {
-    auto toCode = mBoard.get(toRow, toCol);
-    if (notColor(toCode))
-      continue;
-    else if (isSame(toCode, mColor) or not isSame(toCode, piece))
-      break;
-    else
-      return true;
-  }
+  assert(pMove.isEnPassant());
+  auto &bits = mBoard.bits();
+  auto king = bits.pieces(mColor, Piece::K);
+  if (not king)
+    return true;
+
+  // the occupied squares after the capture
+  auto occupied = bits.occupied();
+  occupied ^= squareMask(pMove.sRow(), pMove.sColumn());
+  occupied ^= squareMask(pMove.xRow(), pMove.xColumn());
+  occupied |= squareMask(pMove.dRow(), pMove.dColumn());
+
+  // a check by a knight or a pawn remains, unless the pawn is captured
+  auto index = lsbIndex(king);
+  auto queens = bits.pieces(~mColor, Piece::Q);
+  auto diagonal = bits.pieces(~mColor, Piece::B) | queens;
+  auto straight = bits.pieces(~mColor, Piece::R) | queens;
+  auto captured = squareMask(pMove.xRow(), pMove.xColumn());
+  if (mCheckers & ~diagonal & ~straight & ~captured)
+    return false;
 
-  return false;
+  // a bishop, rook or queen may see the king through the emptied squares
+  return not (Attacks::bishop(index, occupied) & diagonal)
+     and not (Attacks::rook(index, occupied) & straight);
 }
 
 //
-// is it check in column from above
+// find the checks of the position
 //
-bool
-Board::isCheckN(dim_t row, dim_t column, Piece piece) const noexcept
+void
+Board::updateChecks() noexcept
 {
-  assert(not notColor(mColor));
-  assert(BasicBoard::inBoard(row, column));
-
-  // check against piece in colomn from above
-  for (auto toRow = row+1; toRow < BasicBoard::DIM; ++toRow) {
-    auto toCode = mBoard.get(toRow, column);
-    if (notColor(toCode))
-      continue;
-    else if (isSame(toCode, mColor) or not isSame(toCode, piece))
-      break;
-    else
-      return true;
-  }
+  mCheckers = 0;
+  auto king = mBoard.bits().pieces(mColor, Piece::K);
+  if (king)
+    mCheckers = attackers(lsbIndex(king), ~mColor);
+
+  // only the king of the player to move can be in check
+  mInfo.wkCheckSet(isWhite(mColor) and mCheckers);
+  mInfo.bkCheckSet(not isWhite(mColor) and mCheckers);
+  mAttacksValid = 0;
+}
 
-  return false;
+//
+// the pieces of a color attacking a square
+//
+bitboard_t
+Board::attackers(dim_t index, Color color) const noexcept
+{
+  auto &bits = mBoard.bits();
+  auto occupied = bits.occupied();
+  auto queens = bits.pieces(color, Piece::Q);
+  auto diagonal = bits.pieces(color, Piece::B) | queens;
+  auto straight = bits.pieces(color, Piece::R) | queens;
+
+  return (Attacks::pawn(~color, index) & bits.pieces(color, Piece::P))
+       | (Attacks::knight(index) & bits.pieces(color, Piece::N))
+       | (Attacks::king(index) & bits.pieces(color, Piece::K))
+       | (Attacks::bishop(index, occupied) & diagonal)
+       | (Attacks::rook(index, occupied) & straight);
 }
 
 //
-// is it check in row from right
+// find the pieces that attack a square, through the squares that are empty
 //
-bool
-Board::isCheckE(dim_t row, dim_t column, Piece piece) const noexcept
+bitboard_t
+Board::attackers(dim_t index, bitboard_t occupied) const noexcept
 {
-  assert(not notColor(mColor));
-  assert(BasicBoard::inBoard(row, column));
+  auto &bits = mBoard.bits();
+  auto queens = bits.pieces(Piece::Q);
+  auto diagonal = bits.pieces(Piece::B) | queens;
+  auto straight = bits.pieces(Piece::R) | queens;
+
+  return (Attacks::pawn(Color::B, index) & bits.pieces(Color::W, Piece::P))
+       | (Attacks::pawn(Color::W, index) & bits.pieces(Color::B, Piece::P))
+       | (Attacks::knight(index) & bits.pieces(Piece::N))
+       | (Attacks::king(index) & bits.pieces(Piece::K))
+       | (Attacks::bishop(index, occupied) & diagonal)
+       | (Attacks::rook(index, occupied) & straight);
+}
 
-  // check against piece in same row from the right
-  for (auto toCol = column+1; toCol < BasicBoard::DIM; ++toCol) {
-    auto toCode = mBoard.get(row, toCol);
-    if (notColor(toCode))
-      continue;
-    else if (isSame(toCode, mColor) or not isSame(toCode, piece))
-      break;
-    else
-      return true;
+//
+// remove the least valuable attacker
+//
+Piece
+Board::popLeastValuable(bitboard_t attackers, bitboard_t &occupied)
+  const noexcept
+{
+  assert(attackers);
+  Piece pcArr[] = {
+    Piece::P, Piece::N, Piece::B, Piece::R, Piece::Q, Piece::K
+  };
+  for (auto pc : pcArr) {
+    auto pieces = attackers & mBoard.bits().pieces(pc);
+    if (pieces) {
+      occupied ^= pieces & (~pieces + 1);
+      return pc;
+    }
   }
-
-  return false;
+  return Piece::NONE;
 }
 
 //
-// is it check in column from below
+// compute the zobrist key from scratch
 //
-bool
-Board::isCheckS(dim_t row, dim_t column, Piece piece) const noexcept
+Zobrist::key_type
+Board::computeHash() const noexcept
 {
-  assert(not notColor(mColor));
-  assert(BasicBoard::inBoard(row, column));
+  Zobrist::key_type h = 0;
 
-  // check against piece in column from below
-  for (auto toRow = row-1; toRow >= 0; --toRow) {
-    auto toCode = mBoard.get(toRow, column);
-    if (notColor(toCode))
-      continue;
-    else if (isSame(toCode, mColor) or not isSame(toCode, piece))
-      break;
-    else
-      return true;
+  // hash the pieces on the board
+  auto bits = mBoard.bits().occupied();
+  while (bits) {
+    auto index = popLsb(bits);
+    h ^= Zobrist::piece(mBoard.get(index / 8, index % 8), index);
   }
 
-  return false;
+  // hash the turn to move, castling rights, and en passant
+  if (isBlack(mColor))
+    h ^= Zobrist::side();
+  h ^= Zobrist::castle(mInfo.castleBits());
+  h ^= Zobrist::enPassant(enPassantColumn());
+
+  return h;
 }
 
 //
-// is it check in row from left
+// compute the piece-square sums from scratch
 //
-bool
-Board::isCheckW(dim_t row, dim_t column, Piece piece) const noexcept
+PsqtScore
+Board::computePsqt() const noexcept
 {
-  assert(not notColor(mColor));
-  assert(BasicBoard::inBoard(row, column));
+  PsqtScore score = {};
 
-  // check against piece in the same row from left
-  for (auto toCol = column-1; toCol >= 0; --toCol) {
-    auto toCode = mBoard.get(row, toCol);
-    if (notColor(toCode))
-      continue;
-    else if (isSame(toCode, mColor) or not isSame(toCode, piece))
-      break;
-    else
-      return true;
+  auto bits = mBoard.bits().occupied();
+  while (bits) {
+    auto index = popLsb(bits);
+    score.add(mBoard.get(index / 8, index % 8), index);
   }
 
-  return false;
+  return score;
 }
 
 //
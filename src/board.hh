@@ -10,9 +10,11 @@
 // standard headers
 //
 #include <cassert>
+#include <cstdint>
 #include <functional>
 #include <ostream>
 #include <string>
+#include <type_traits>
 #include <vector>
 #include <utility>
 
@@ -21,10 +23,15 @@
 //
 #include "basictypes.hh"
 #include "basicboard.hh"
+#include "bitboard.hh"
 #include "boardinfo.hh"
 #include "chesserror.hh"
+#include "movelist.hh"
+#include "moveundo.hh"
 #include "piecemove.hh"
+#include "psqt.hh"
 #include "square.hh"
+#include "zobrist.hh"
 
 namespace zoor {
 
@@ -43,6 +50,12 @@ namespace zoor {
 //! prior moves if we are not playing a game but only analysing a position. In
 //! real life, it is the player's job to know the series of moves that led to a
 //! given position.
+//!
+//! A Board is not safe to share between threads, even as a <em>const
+//! Board</em>: the maps of attacked squares are cached on first use, so some
+//! const functions, e.g., attacks(), isLegal() and the move generators, write
+//! to the board. Each thread should work on its own copy, as
+//! @c ParallelSearch and @c ParallelPerft do. Copying a Board is cheap.
 class Board {
 public:
   //! @brief The board iterator
@@ -60,6 +73,17 @@ public:
   //! @brief The jump deltas for a king.
   static const jump_list JUMP_KING;
 
+  //! @brief The kinds of moves that getLegalMoves() can generate.
+  //! @details Captures include en passant and every promotion, because they
+  //! change the material on the board. Quiet moves are the other moves,
+  //! including castling.
+  enum class GenType
+  {
+    ALL,
+    CAPTURES,
+    QUIETS
+  };
+
   //! @brief Default constructor.
   //! @details Initializes a board with the standard number of pieces, with
   //! white's turn to move.
@@ -131,11 +155,124 @@ public:
   std::vector<PieceMove>
   getMoves() const;
 
+  //! @brief Add the legal moves from the given position to a list.
+  //! @details Does not allocate memory.
+  //! @param row The row in the board.
+  //! @param col The column in the board.
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  getMoves(dim_t row, dim_t col, MoveList &moveList) const noexcept;
+
+  //! @brief Add the legal moves from all the pieces on the board to a list.
+  //! @details Does not allocate memory. The moves are added in the same order
+  //! as getMoves().
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  getMoves(MoveList &moveList) const noexcept;
+
+  //! @brief Return a vector of the legal moves of the player to move.
+  //! @details Unlike getMoves(), none of the moves leave the king of the
+  //! player in check. The moves are in the same order as getMoves().
+  //! @return A vector of the legal moves. An empty vector if it is checkmate
+  //! or stalemate.
+  std::vector<PieceMove>
+  getLegalMoves() const;
+
+  //! @brief Add the legal moves of the player to move to a list.
+  //! @details Does not allocate memory. The pinned pieces and the checks are
+  //! found before the moves are generated, so the moves need not be made to
+  //! find out if they are legal. In check, a piece other than the king can
+  //! only capture the checking piece or block the check, and in double check
+  //! only the king can move.
+  //! @param moveList The list where the moves are added.
+  //! @param type The kind of moves to add.
+  //! @throw Never throws.
+  void
+  getLegalMoves(MoveList &moveList, GenType type = GenType::ALL) const noexcept;
+
+  //! @brief Determine if the player to move has a legal move.
+  //! @details Stops at the first legal move found, without adding the moves to
+  //! a list, so it is much cheaper than getLegalMoves() to tell a checkmate or
+  //! a stalemate apart from other positions.
+  //! @return True if there is at least one legal move.
+  //! @throw Never throws.
+  bool
+  hasLegalMove() const noexcept;
+
+  //! @brief Count the legal moves of the player to move.
+  //! @details Counts the target squares of each piece, with the same pins and
+  //! checks as getLegalMoves(), but without making a @c PieceMove for each
+  //! move. Each promotion to a different piece counts as a move.
+  //! @return The number of moves that getLegalMoves() would return.
+  //! @throw Never throws.
+  int
+  countLegalMoves() const noexcept;
+
+  //! @brief Get the pieces of the player to move that are pinned to their
+  //! king.
+  //! @details A piece is pinned if it is the only piece between its king and a
+  //! bishop, rook or queen of the other color on the same line.
+  //! @return The squares of the pinned pieces.
+  //! @throw Never throws.
+  bitboard_t
+  pinned() const noexcept;
+
+  //! @brief Determine if a move is one of the moves returned by getMoves().
+  //! @details Checks the move directly, without generating the moves of the
+  //! piece: the piece is on its square, the move fits how the piece moves and
+  //! the pieces in its way, and the captured piece, the promotion, en passant
+  //! and castling are encoded as getMoves() encodes them.
+  //! @param pMove The @c PieceMove.
+  //! @return True if the move can be made on this board, even if it leaves the
+  //! king in check.
+  //! @throw Never throws.
+  bool
+  isPseudoLegal(const PieceMove &pMove) const noexcept;
+
+  //! @brief Determine if a move is one of the moves returned by
+  //! getLegalMoves().
+  //! @details Like isPseudoLegal(), and also checks that the move does not
+  //! leave the king in check, with the pins and checks of the position. Meant
+  //! to verify a move that does not come from the move generator, e.g., the
+  //! move of a transposition table entry or a move read from a user.
+  //! @param pMove The @c PieceMove.
+  //! @return True if the move is legal.
+  //! @throw Never throws.
+  bool
+  isLegal(const PieceMove &pMove) const noexcept;
+
+  //! @brief Static exchange evaluation of a move.
+  //! @details Plays out the captures on the square where the move goes, each
+  //! one with the least valuable attacker, including the attackers that are
+  //! behind other sliding pieces, and lets each player stop capturing when it
+  //! is better to do so. Pins are not taken into account, nor promotions after
+  //! the first move, and a king only captures a piece that is not defended.
+  //! @param pMove The @c PieceMove, which must be legal.
+  //! @return The material won by the player to move, in centipawns. Negative
+  //! if the move loses material, and 0 for castling.
+  //! @throw Never throws.
+  int
+  see(const PieceMove &pMove) const noexcept;
+
+  //! @brief Determine if the static exchange evaluation of a move reaches a
+  //! threshold.
+  //! @details The same as <em>see(pMove) >= threshold</em>, but stops as soon
+  //! as the answer is known, which is often after the first capture.
+  //! @param pMove The @c PieceMove, which must be legal.
+  //! @param threshold The least material that the move must win.
+  //! @return True if the move wins at least the threshold.
+  //! @throw Never throws.
+  bool
+  seeGE(const PieceMove &pMove, int threshold) const noexcept;
+
   //! @brief Return a vector of all the boards that can be reached from this
   //! board in one move.
   //! @details If there are no legal moves, then the vector of boards will be
   //! empty. This may mean that the current position is a checkmate, a
-  //! stalemate, or that there are no pieces on the board.
+  //! stalemate, or that there are no pieces on the board. Use @c ChildBoards
+  //! to visit the boards one at a time without a copy of each.
   //! @return A vector of all the legal moves from the current position.
   std::vector<Board>
   getBoards() const;
@@ -150,13 +287,35 @@ public:
 
   //! @brief Make a move on the current board.
   //! @details This move will become the new last move. Meant to be used to take
-  //! a board to a position.
+  //! a board to a position. The move is verified with isPseudoLegal().
   //! @param pMove The @c PieceMove.
   //! @return A reference to this @c Board.
   //! @throw Never throws.
   Board&
   makeMove(const PieceMove &pMove);
 
+  //! @brief Make a move on the current board, so that it can be taken back.
+  //! @details Unlike makeMove(const PieceMove&), the move is not verified. It
+  //! must be one of the moves returned by getMoves() for this position. Meant
+  //! to be used to walk a tree of positions on a single board, by pairing each
+  //! call with a call to unmakeMove().
+  //! @param pMove The @c PieceMove.
+  //! @param undo Filled with the state needed to take back the move.
+  //! @return A reference to this @c Board.
+  //! @throw Never throws.
+  Board&
+  makeMove(const PieceMove &pMove, MoveUndo &undo) noexcept;
+
+  //! @brief Take back the last move made on the board.
+  //! @details The last move must have been made with
+  //! makeMove(const PieceMove&, MoveUndo&), and moves must be taken back in
+  //! the reverse order in which they were made.
+  //! @param undo The state saved when the move was made.
+  //! @return A reference to this @c Board.
+  //! @throw Never throws.
+  Board&
+  unmakeMove(const MoveUndo &undo) noexcept;
+
   //! @brief Get the last move made on this board.
   //! @return A copy of the last move.
   //! @throw Never throws.
@@ -211,8 +370,9 @@ public:
   //! @param row The row where the king is located.
   //! @param column The column where the king is located.
   //! @return True if there is a check at the given square.
+  //! @throw Never throws.
   bool
-  isCheckKnight(dim_t row, dim_t column) const;
+  isCheckKnight(dim_t row, dim_t column) const noexcept;
 
   //! @brief Determine if there is a bishop check at the given row and column.
   //! @param row The row where the king is located.
@@ -242,15 +402,62 @@ public:
   //! @param row The row where the king is located.
   //! @param column The column where the king is located.
   //! @return True if there is a check at the given square.
+  //! @throw Never throws.
   bool
-  isCheckKing(dim_t row, dim_t column) const;
+  isCheckKing(dim_t row, dim_t column) const noexcept;
 
   //! @brief Determine if there is a check at the given row and column.
   //! @param row The row where the king is located.
   //! @param column The column where the king is located.
   //! @return True if there is a check at the given square.
+  //! @throw Never throws.
+  bool
+  isCheck(dim_t row, dim_t column) const noexcept;
+
+  //! @brief Determine if a square is attacked by the pieces of a given color.
+  //! @param row The row of the square.
+  //! @param column The column of the square.
+  //! @param color The color of the attacking pieces.
+  //! @return True if a piece of the given color attacks the square.
+  //! @throw Never throws.
+  bool
+  isAttacked(dim_t row, dim_t column, Color color) const noexcept;
+
+  //! @brief Determine if the king of a given color is attacked.
+  //! @details Called with the color of the player that just moved, it tells
+  //! if the last move left its own king in check, i.e., if it was not legal.
+  //! @param color The color of the king.
+  //! @return True if the king is attacked, false if it is not or if there is
+  //! no king of the given color.
+  //! @throw Never throws.
+  bool
+  isKingAttacked(Color color) const noexcept;
+
+  //! @brief Get the pieces that give check to the king of the player to move.
+  //! @details Found once for every position, when the board is created or a
+  //! move is made.
+  //! @return The squares of the checking pieces, or zero if there is no check.
+  //! @throw Never throws.
+  bitboard_t
+  checkers() const noexcept;
+
+  //! @brief Determine if the king of the player to move is in check.
+  //! @return True if the king is in check.
+  //! @throw Never throws.
   bool
-  isCheck(dim_t row, dim_t column) const;
+  inCheck() const noexcept;
+
+  //! @brief Get the squares attacked by the pieces of a given color.
+  //! @details The attacks of the sliding pieces go through the king of the
+  //! other color, so that the king cannot step back along the line of a check.
+  //! The map is computed the first time it is needed in a position, and then
+  //! reused until a move is made, so this writes to the board even though it
+  //! is const.
+  //! @param color The color of the attacking pieces.
+  //! @return The attacked squares.
+  //! @throw Never throws.
+  bitboard_t
+  attacks(Color color) const noexcept;
 
   //! @brief Determine if there is an en passant at a given column.
   //! @param color The @c Color.
@@ -268,6 +475,14 @@ public:
   std::vector<PieceMove>
   movePawn(dim_t row, dim_t column) const;
 
+  //! @brief Add the moves of the pawn at the given row and column to a list.
+  //! @param row The row where the pawn is located.
+  //! @param column The column where the pawn is located.
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  movePawn(dim_t row, dim_t column, MoveList &moveList) const noexcept;
+
   //! @brief Move the knight at the given row and column.
   //! @param row The row where the knight is located.
   //! @param column The column where the knight is located.
@@ -275,6 +490,14 @@ public:
   std::vector<PieceMove>
   moveKnight(dim_t row, dim_t column) const;
 
+  //! @brief Add the moves of the knight at the given row and column to a list.
+  //! @param row The row where the knight is located.
+  //! @param column The column where the knight is located.
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  moveKnight(dim_t row, dim_t column, MoveList &moveList) const noexcept;
+
   //! @brief Move the bishop at the given row and column.
   //! @param row The row where the bishop is located.
   //! @param column The column where the bishop is located.
@@ -282,6 +505,14 @@ public:
   std::vector<PieceMove>
   moveBishop(dim_t row, dim_t column) const;
 
+  //! @brief Add the moves of the bishop at the given row and column to a list.
+  //! @param row The row where the bishop is located.
+  //! @param column The column where the bishop is located.
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  moveBishop(dim_t row, dim_t column, MoveList &moveList) const noexcept;
+
   //! @brief Move the rook at the given row and column.
   //! @param row The row where the rook is located.
   //! @param column The column where the rook is located.
@@ -289,6 +520,14 @@ public:
   std::vector<PieceMove>
   moveRook(dim_t row, dim_t column) const;
 
+  //! @brief Add the moves of the rook at the given row and column to a list.
+  //! @param row The row where the rook is located.
+  //! @param column The column where the rook is located.
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  moveRook(dim_t row, dim_t column, MoveList &moveList) const noexcept;
+
   //! @brief Move the queen at the given row and column.
   //! @param row The row where the queen is located.
   //! @param column The column where the queen is located.
@@ -296,6 +535,14 @@ public:
   std::vector<PieceMove>
   moveQueen(dim_t row, dim_t column) const;
 
+  //! @brief Add the moves of the queen at the given row and column to a list.
+  //! @param row The row where the queen is located.
+  //! @param column The column where the queen is located.
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  moveQueen(dim_t row, dim_t column, MoveList &moveList) const noexcept;
+
   //! @brief Move the king at the given row and column.
   //! @param row The row where the king is located.
   //! @param column The column where the king is located.
@@ -303,19 +550,53 @@ public:
   std::vector<PieceMove>
   moveKing(dim_t row, dim_t column) const;
 
+  //! @brief Add the moves of the king at the given row and column to a list.
+  //! @param row The row where the king is located.
+  //! @param column The column where the king is located.
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  moveKing(dim_t row, dim_t column, MoveList &moveList) const noexcept;
+
   //! @brief Return string representation of the board.
   //! @return A string representing the board.
   std::string
   toString() const;
 
   //! @brief Get the hash code for this board.
-  //! @details Hashes the raw contents of the board and the color reprsenting
-  //! whose turn is it to move, which are also the two characteristics used to
-  //! determine equality. Implemented using One-at-a-Time hash
+  //! @details The Zobrist key of the position, which covers the pieces on the
+  //! board, whose turn it is to move, the castling rights, and the column where
+  //! en passant is possible. The key is kept up to date as moves are made, so
+  //! this is a constant time operation.
   //! @return The numeric hash code for this board.
+  //! @throw Never throws.
   size_t
   hashCode() const noexcept;
 
+  //! @brief Get the piece-square sums of the position.
+  //! @details Kept up to date as moves are made, like the hash.
+  //! @return A const reference to the sums of each color.
+  //! @throw Never throws.
+  const PsqtScore&
+  psqt() const noexcept;
+
+  //! @brief Score the material and the squares of the pieces.
+  //! @details Blends the middlegame and the endgame sums by the game phase. A
+  //! constant time operation.
+  //! @return The score of the player to move, in centipawns.
+  //! @throw Never throws.
+  int
+  psqtScore() const noexcept;
+
+  //! @brief The column where the player to move can capture en passant.
+  //! @details Only set if the last move was a pawn moving two squares, and a
+  //! pawn of the player to move is next to it.
+  //! @return The column of the pawn that can be captured, or -1 if there is no
+  //! en passant.
+  //! @throw Never throws.
+  dim_t
+  enPassantColumn() const noexcept;
+
   //! @brief Get the color of whose turn it is to move.
   //! @return The color of the player whose turn it is to move.
   Color
@@ -345,92 +626,172 @@ private:
   Board&
   moveRef(const PieceMove &pMove) noexcept;
 
-  //! @brief Determine if there is a check at the given row and column from a
-  //! piece in the diagonal up and to the right.
-  //! @details Can use this to determine if there is a check from a bishop or a
-  //! queen.
-  //! @param row The row where the king might be located.
-  //! @param column The column where the king might be located.
-  //! @return True if there is a check.
+  //! @brief Turn on the flag for the rook in a corner, if the square is a
+  //! corner.
+  //! @details Used when a rook moves from a square or is captured on it.
+  //! @param row The row of the square.
+  //! @param column The column of the square.
   //! @throw Never throws.
-  bool
-  isCheckNE(dim_t row, dim_t column, Piece piece) const noexcept;
-
-  //! @brief Determine if there is a check at the given row and column from a
-  //! piece in the diagonal down and to the right.
-  //! @details Can use this to determine if there is a check from a bishop or a
-  //! queen.
-  //! @param row The row where the king might be located.
-  //! @param column The column where the king might be located.
-  //! @return True if there is a check.
-  //! @throw Never throws.
-  bool isCheckSE(dim_t row, dim_t column, Piece piece) const noexcept;
-
-  //! @brief Determine if there is a check at the given row and column from a
-  //! piece in the diagonal down and to the left.
-  //! @details Can use this to determine if there is a check from a bishop or a
-  //! queen.
-  //! @param row The row where the king might be located.
-  //! @param column The column where the king might be located.
-  //! @return True if there is a check.
+  void
+  rookMoved(dim_t row, dim_t column) noexcept;
+
+  //! @brief Put a piece on a square and update the hash and the piece-square
+  //! sums.
+  //! @details Any piece already on the square is removed first.
+  //! @param row The row of the square.
+  //! @param column The column of the square.
+  //! @param code The piece code.
   //! @throw Never throws.
-  bool
-  isCheckSW(dim_t row, dim_t column, Piece piece) const noexcept;
+  void
+  putPiece(dim_t row, dim_t column, piece_t code) noexcept;
 
-  //! @brief Determine if there is a  check at the given row and column from a
-  //! piece in the diagonal up and to the left.
-  //! @details Can use this to determine if there is a check from a bishop or a
-  //! queen.
-  //! @param row The row where the king might be located.
-  //! @param column The column where the king might be located.
-  //! @return True if there is a check.
+  //! @brief Remove the piece from a square and update the hash and the
+  //! piece-square sums.
+  //! @param row The row of the square.
+  //! @param column The column of the square.
   //! @throw Never throws.
-  bool
-  isCheckNW(dim_t row, dim_t column, Piece piece) const noexcept;
+  void
+  clearPiece(dim_t row, dim_t column) noexcept;
+
+  //! @brief Add the moves of a piece to a set of target squares.
+  //! @param row The row of the piece.
+  //! @param column The column of the piece.
+  //! @param fromCode The piece code.
+  //! @param targets The target squares, which must not hold pieces of the
+  //! same color.
+  //! @param moveList The list where the moves are added.
+  //! @throw Never throws.
+  void
+  addMoves(dim_t row, dim_t column, piece_t fromCode, bitboard_t targets,
+           MoveList &moveList) const noexcept;
 
-  //! @brief Determine if there is a check at the given row and column from a
-  //! piece in the column from above.
-  //! @details Can use this to determine if there is a check from a rook or a
-  //! queen.
-  //! @param row The row where the king might be located.
-  //! @param column The column where the king might be located.
-  //! @return True if there is a check.
+  //! @brief Add the captures and promotions of the pawn at the given row and
+  //! column to a list, without generating its other moves.
+  //! @tparam C The color of the player to move.
+  //! @param row The row where the pawn is located.
+  //! @param column The column where the pawn is located.
+  //! @param moveList The list where the moves are added.
   //! @throw Never throws.
-  bool
-  isCheckN(dim_t row, dim_t column, Piece piece) const noexcept;
+  template<Color C>
+  void
+  addPawnCaptures(dim_t row, dim_t column, MoveList &moveList) const noexcept;
 
-  //! @brief Determine if there is a check at the given row and column from a
-  //! piece in the row from the right.
-  //! @details Can use this to determine if there is a check from a rook or a
-  //! queen.
-  //! @param row The row where the king might be located.
-  //! @param column The column where the king might be located.
-  //! @return True if there is a check.
+  //! @brief Add the castling moves of the player to move, if there are any.
+  //! @param moveList The list where the moves are added.
   //! @throw Never throws.
+  void
+  addCastles(MoveList &moveList) const noexcept;
+
+  //! @brief The move generators and checks for a player, with the color of the
+  //! player fixed at compile time.
+  //! @details The versions without a template parameter test the color of the
+  //! player to move once, and call these, so that the rows and the direction
+  //! of the pawns and the castling squares are constants in their loops. They
+  //! are only instantiated in board.cc. Each one has the same contract as its
+  //! version without a template parameter, for the player to move of color C.
+  //! @tparam C The color of the player to move.
+  //! @{
+  template<Color C>
   bool
-  isCheckE(dim_t row, dim_t column, Piece piece) const noexcept;
+  canCastle() const noexcept;
 
-  //! @brief Determine if there is a check at the given row and column from a
-  //! piece in the column from below.
-  //! @details Can use this to determine if there is a check from a rook or a
-  //! queen.
-  //! @param row The row where the king might be located.
-  //! @param column The column where the king might be located.
-  //! @return True if there is a check.
-  //! @throw Never throws.
+  template<Color C>
   bool
-  isCheckS(dim_t row, dim_t column, Piece piece) const noexcept;
+  canCastleLong() const noexcept;
+
+  template<Color C>
+  void
+  getMoves(MoveList &moveList) const noexcept;
 
-  //! @brief Determine if there is a check at the given row and column from a
-  //! piece in the row from the left.
-  //! @details Can use this to determine if there is a check from a rook or a
-  //! queen.
-  //! @param row The row where the king might be located.
-  //! @param column The column where the king might be located.
-  //! @return True if there is a check.
+  template<Color C>
+  void
+  getLegalMoves(MoveList &moveList, GenType type) const noexcept;
+
+  template<Color C>
+  bool
+  isCheckPawn(dim_t row, dim_t column) const noexcept;
+
+  template<Color C>
+  bool
+  isEnPassant(dim_t toColumn) const noexcept;
+
+  template<Color C>
+  bool
+  isPseudoLegal(const PieceMove &pMove) const noexcept;
+
+  template<Color C>
+  void
+  movePawn(dim_t row, dim_t column, MoveList &moveList) const noexcept;
+
+  template<Color C>
+  void
+  addCastles(MoveList &moveList) const noexcept;
+  //! @}
+
+  //! @brief Count the legal moves of the player to move, of color C.
+  //! @tparam C The color of the player to move.
+  //! @param limit The count at which counting may stop.
+  //! @return The number of legal moves, or a number that is at least the
+  //! limit.
+  //! @throw Never throws.
+  template<Color C>
+  int
+  countLegalMoves(int limit) const noexcept;
+
+  //! @brief Determine if an en passant capture leaves the king in check.
+  //! @details The two pawns leave the row of the king at once, which may open
+  //! a line to it.
+  //! @param pMove The en passant capture.
+  //! @return True if the king is not in check after the capture.
   //! @throw Never throws.
   bool
-  isCheckW(dim_t row, dim_t column, Piece piece) const noexcept;
+  isEnPassantLegal(const PieceMove &pMove) const noexcept;
+
+  //! @brief Compute the hash from scratch.
+  //! @return The Zobrist key of the position.
+  //! @throw Never throws.
+  Zobrist::key_type
+  computeHash() const noexcept;
+
+  //! @brief Compute the piece-square sums from scratch.
+  //! @return The sums of the pieces on the board.
+  //! @throw Never throws.
+  PsqtScore
+  computePsqt() const noexcept;
+
+  //! @brief Find the checks of the position, and set the check flags of the
+  //! king info to match them.
+  //! @details Also drops the attack maps of the previous position.
+  //! @throw Never throws.
+  void
+  updateChecks() noexcept;
+
+  //! @brief Find the pieces of a given color that attack a square.
+  //! @param index The index of the square.
+  //! @param color The color of the attacking pieces.
+  //! @return The squares of the attacking pieces.
+  //! @throw Never throws.
+  bitboard_t
+  attackers(dim_t index, Color color) const noexcept;
+
+  //! @brief Find the pieces of both colors that attack a square, with the
+  //! sliding pieces blocked only by the occupied squares given.
+  //! @param index The index of the square.
+  //! @param occupied The occupied squares.
+  //! @return The squares of the attacking pieces, which may include pieces
+  //! that are not in the occupied squares.
+  //! @throw Never throws.
+  bitboard_t
+  attackers(dim_t index, bitboard_t occupied) const noexcept;
+
+  //! @brief Remove the least valuable of a set of attackers.
+  //! @param attackers The squares of the attackers, which must not be empty.
+  //! @param occupied The occupied squares, from which the attacker is
+  //! removed.
+  //! @return The piece that was removed.
+  //! @throw Never throws.
+  Piece
+  popLeastValuable(bitboard_t attackers, bitboard_t &occupied) const noexcept;
 
   // The underlying board.
   BasicBoard mBoard;
@@ -449,8 +810,27 @@ private:
   //
   BoardInfo mInfo;
 
+  // The Zobrist key of the position.
+  Zobrist::key_type mHash;
+
+  // The piece-square sums of the position.
+  PsqtScore mPsqt;
+
+  // The pieces that give check to the king of the player to move.
+  bitboard_t mCheckers;
+
+  // The squares attacked by each color, indexed by color. A cache written by
+  // const functions, which is why a Board cannot be shared between threads.
+  mutable bitboard_t mAttacks[2];
+
+  // Bit i is set if mAttacks[i] is up to date.
+  mutable uint8_t mAttacksValid;
+
 }; // Board
 
+static_assert(std::is_trivially_copyable<Board>::value,
+              "Board must be copied without allocation");
+
 //! @brief Writes the current board position to an output stream.
 //! @param os The output stream.
 //! @param board The board.
@@ -459,9 +839,9 @@ std::ostream&
 operator<<(std::ostream &os, const Board &board);
 
 //! @brief Equality operator.
-//! @details The board position, and who's turn is it to play determine the
-//! uniqueness of a board, and whether two boards are equal or not. Therefore,
-//! it is enough to look the eight rows and who's turn it is.
+//! @details The board position, who's turn is it to play, the king info, and
+//! the column where en passant is possible determine the uniqueness of a
+//! board, and whether two boards are equal or not.
 //! @param board1 The first board.
 //! @param board2 The second board.
 //! @return True if boards are equal, false otherwise.
@@ -470,9 +850,9 @@ bool
 operator==(const Board &boar1, const Board &board2) noexcept;
 
 //! @brief Non-equality operator.
-//! @details The board position, and who's turn is it to play determine the
-//! uniqueness of a board, and whether two boards are equal or not. Therefore,
-//! it is enough to look the eight rows and who's turn it is.
+//! @details The board position, who's turn is it to play, the king info, and
+//! the column where en passant is possible determine the uniqueness of a
+//! board, and whether two boards are equal or not.
 //! @param board1 The first board.
 //! @param board2 The second board.
 //! @return False if boards are equal, true otherwise.
@@ -554,6 +934,24 @@ Board::nextTurn() const noexcept
   return mColor;
 }
 
+//
+// the pieces giving check
+//
+inline bitboard_t
+Board::checkers() const noexcept
+{
+  return mCheckers;
+}
+
+//
+// is the player to move in check
+//
+inline bool
+Board::inCheck() const noexcept
+{
+  return mCheckers != 0;
+}
+
 //
 // get the info for castling rights, check on king, and mate
 //
@@ -564,7 +962,34 @@ Board::kingInfo() const noexcept
 }
 
 //
-// determine whether it is white's or black's turn to move
+// get the zobrist key of the board
+//
+inline size_t
+Board::hashCode() const noexcept
+{
+  return static_cast<size_t>(mHash);
+}
+
+//
+// get the piece-square sums
+//
+inline const PsqtScore&
+Board::psqt() const noexcept
+{
+  return mPsqt;
+}
+
+//
+// score the piece-square sums for the player to move
+//
+inline int
+Board::psqtScore() const noexcept
+{
+  return mPsqt.value(mColor);
+}
+
+//
+// get the underlying board
 //
 inline const BasicBoard&
 Board::base() const noexcept
@@ -592,6 +1017,7 @@ operator==(const Board &board1, const Board &board2) noexcept
 {
   return board1.nextTurn() == board2.nextTurn()
       && board1.kingInfo() == board2.kingInfo()
+      && board1.enPassantColumn() == board2.enPassantColumn()
       && board1.base() == board2.base();
 }
 
@@ -154,6 +154,9 @@ public:
   // General utility functions.
   //
 
+  unsigned
+  castleBits() const noexcept;
+
   std::string
   toString() const;
 
@@ -445,6 +448,28 @@ BoardInfo::bkCastleLong() const noexcept
   return !value;
 }
 
+//! @brief The castling rights that are still available.
+//! @details Only the bits for rooks and kings that have moved are used, so the
+//! result does not change when a king is in check. Bit 0 is set if white may
+//! still castle short, bit 1 if white may still castle long, and bits 2 and 3
+//! are the same for black.
+//! @return The castling rights, a value in the range [0, 16).
+//! @throw Never throws.
+inline unsigned
+BoardInfo::castleBits() const noexcept
+{
+  unsigned bits = 0;
+  if (not mInfo[WK_MOVED]) {
+    bits |= mInfo[RK_H1_MOVED] ? 0 : 1;
+    bits |= mInfo[RK_A1_MOVED] ? 0 : 2;
+  }
+  if (not mInfo[BK_MOVED]) {
+    bits |= mInfo[RK_H8_MOVED] ? 0 : 4;
+    bits |= mInfo[RK_A8_MOVED] ? 0 : 8;
+  }
+  return bits;
+}
+
 //! @return A string representation of the @c BoardInfo.
 //! @details The representation is the same as the string representation for the
 //! underlying bitset.
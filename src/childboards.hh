@@ -0,0 +1,272 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file childboards.hh
+//! @author Omar A Serrano
+//! @date 2016-10-24
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _CHILDBOARDS_H
+#define _CHILDBOARDS_H
+
+//
+// STL
+//
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+
+//
+// zoor
+//
+#include "board.hh"
+#include "movelist.hh"
+#include "moveundo.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief A range over the boards that can be reached from a board in one
+//! move, made one at a time.
+//! @details Yields the same boards, in the same order, as Board::getBoards(),
+//! but keeps a single scratch board instead of a copy for each child. Each
+//! move is made on the scratch board when the iterator reaches it, and taken
+//! back when the iterator moves on, so a loop that stops early never makes the
+//! moves after it. Since there is one scratch board, a child is only valid
+//! until the iterator is incremented, and the range can be walked only once.
+//! Meant to be used in a range for loop:
+//! @code
+//! for (const Board &child : ChildBoards(board))
+//!   use(child);
+//! @endcode
+class ChildBoards
+{
+public:
+  //! @brief An input iterator over the children.
+  class iterator
+  {
+  public:
+    //! @brief Aliases for the iterator traits.
+    using iterator_category = std::input_iterator_tag;
+    using value_type = Board;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Board*;
+    using reference = const Board&;
+
+    //! @brief Ctor with the range and the index of the child.
+    //! @param range The range being walked.
+    //! @param index The index of the child's move.
+    //! @throw Never throws.
+    iterator(ChildBoards &range, std::size_t index) noexcept;
+
+    //! @return A const reference to the child, on the scratch board.
+    //! @throw Never throws.
+    reference
+    operator*() const noexcept;
+
+    //! @return A pointer to the child, on the scratch board.
+    //! @throw Never throws.
+    pointer
+    operator->() const noexcept;
+
+    //! @brief Move on to the next child.
+    //! @return A reference to this iterator.
+    //! @throw Never throws.
+    iterator&
+    operator++() noexcept;
+
+    //! @param it The other iterator.
+    //! @return True if both iterators are at the same child.
+    //! @throw Never throws.
+    bool
+    operator==(const iterator &it) const noexcept;
+
+    //! @param it The other iterator.
+    //! @return True if the iterators are at different children.
+    //! @throw Never throws.
+    bool
+    operator!=(const iterator &it) const noexcept;
+
+  private:
+    // The range being walked.
+    ChildBoards *mRange;
+
+    // The index of the child's move.
+    std::size_t mIndex;
+  };
+
+  //! @brief Ctor with the parent board.
+  //! @details Generates the moves of the board, but does not make any.
+  //! @param board The parent board.
+  //! @throw Never throws.
+  explicit
+  ChildBoards(const Board &board) noexcept;
+
+  //! @brief Make the first move on the scratch board.
+  //! @return An iterator to the first child.
+  //! @throw Never throws.
+  iterator
+  begin() noexcept;
+
+  //! @return An iterator to one past the last child.
+  //! @throw Never throws.
+  iterator
+  end() noexcept;
+
+  //! @return The number of children.
+  //! @throw Never throws.
+  std::size_t
+  size() const noexcept;
+
+  //! @param index The index of a child.
+  //! @return The move that leads to the child.
+  //! @throw Never throws.
+  const PieceMove&
+  move(std::size_t index) const noexcept;
+
+private:
+  //! @brief Put the scratch board at a child.
+  //! @details Takes back the move of the child it is at, if any, and makes
+  //! the move of the given child, if it is not the end.
+  //! @param index The index of the child.
+  //! @throw Never throws.
+  void
+  seek(std::size_t index) noexcept;
+
+  // The moves of the parent board.
+  MoveList mMoves;
+
+  // The parent board, with the move of the current child made on it.
+  Board mScratch;
+
+  // The state needed to take back the current move.
+  MoveUndo mUndo;
+
+  // The index of the move made on the scratch board, or size() if none.
+  std::size_t mMade;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// iterator ctor
+//
+inline
+ChildBoards::iterator::iterator(ChildBoards &range, std::size_t index) noexcept
+  : mRange(&range),
+    mIndex(index) {}
+
+//
+// the current child
+//
+inline ChildBoards::iterator::reference
+ChildBoards::iterator::operator*() const noexcept
+{
+  assert(mRange->mMade == mIndex);
+  return mRange->mScratch;
+}
+
+//
+// pointer to the current child
+//
+inline ChildBoards::iterator::pointer
+ChildBoards::iterator::operator->() const noexcept
+{
+  return &**this;
+}
+
+//
+// next child
+//
+inline ChildBoards::iterator&
+ChildBoards::iterator::operator++() noexcept
+{
+  mRange->seek(++mIndex);
+  return *this;
+}
+
+//
+// compare iterators for equality
+//
+inline bool
+ChildBoards::iterator::operator==(const iterator &it) const noexcept
+{
+  return mRange == it.mRange and mIndex == it.mIndex;
+}
+
+//
+// compare iterators for non-equality
+//
+inline bool
+ChildBoards::iterator::operator!=(const iterator &it) const noexcept
+{
+  return !(*this == it);
+}
+
+//
+// ctor with the parent board
+//
+inline
+ChildBoards::ChildBoards(const Board &board) noexcept
+  : mScratch(board)
+{
+  board.getMoves(mMoves);
+  mMade = mMoves.size();
+}
+
+//
+// first child
+//
+inline ChildBoards::iterator
+ChildBoards::begin() noexcept
+{
+  seek(0);
+  return iterator(*this, 0);
+}
+
+//
+// one past the last child
+//
+inline ChildBoards::iterator
+ChildBoards::end() noexcept
+{
+  return iterator(*this, mMoves.size());
+}
+
+//
+// number of children
+//
+inline std::size_t
+ChildBoards::size() const noexcept
+{
+  return mMoves.size();
+}
+
+//
+// move of a child
+//
+inline const PieceMove&
+ChildBoards::move(std::size_t index) const noexcept
+{
+  return mMoves[index];
+}
+
+//
+// put the scratch board at a child
+//
+inline void
+ChildBoards::seek(std::size_t index) noexcept
+{
+  if (mMade < mMoves.size())
+    mScratch.unmakeMove(mUndo);
+
+  mMade = index < mMoves.size() ? index : mMoves.size();
+  if (mMade < mMoves.size())
+    mScratch.makeMove(mMoves[mMade], mUndo);
+}
+
+} // namespace zoor
+#endif // _CHILDBOARDS_H
@@ -0,0 +1,299 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file movelist.hh
+//! @author Omar A Serrano
+//! @date 2016-10-09
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _MOVELIST_H
+#define _MOVELIST_H
+
+//
+// STL
+//
+#include <cassert>
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+//
+// zoor
+//
+#include "piecemove.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief A list of moves with a fixed capacity, stored inline.
+//! @details Meant to be created on the stack by move generation, so that
+//! generating the moves of a position does not allocate memory. The capacity
+//! is larger than the number of moves in any position. Only the moves that
+//! have been added are constructed.
+class MoveList
+{
+public:
+  //! @brief The maximum number of moves in the list.
+  enum { CAPACITY = 256 };
+
+  //! @brief Alias for the type of the moves.
+  using value_type = PieceMove;
+
+  //! @brief Alias for the size type.
+  using size_type = std::size_t;
+
+  //! @brief Alias for an iterator.
+  using iterator = PieceMove*;
+
+  //! @brief Alias for a const iterator.
+  using const_iterator = const PieceMove*;
+
+  //! @brief Default ctor.
+  //! @details Initializes an empty list.
+  //! @throw Never throws.
+  MoveList() noexcept;
+
+  //! @brief Add a move at the end of the list.
+  //! @details The list must not be full.
+  //! @param args The arguments passed to the ctor of the @c PieceMove.
+  //! @return A reference to the new move.
+  //! @throw Never throws.
+  template<typename... Args>
+  PieceMove&
+  emplace_back(Args&&... args) noexcept;
+
+  //! @brief Add a copy of a move at the end of the list.
+  //! @details The list must not be full.
+  //! @param pMove The @c PieceMove.
+  //! @throw Never throws.
+  void
+  push_back(const PieceMove &pMove) noexcept;
+
+  //! @brief Remove the last move from the list.
+  //! @details The list must not be empty.
+  //! @throw Never throws.
+  void
+  pop_back() noexcept;
+
+  //! @brief Remove all the moves from the list.
+  //! @throw Never throws.
+  void
+  clear() noexcept;
+
+  //! @return The number of moves in the list.
+  //! @throw Never throws.
+  size_type
+  size() const noexcept;
+
+  //! @return True if there are no moves in the list.
+  //! @throw Never throws.
+  bool
+  empty() const noexcept;
+
+  //! @return A reference to the last move in the list.
+  //! @throw Never throws.
+  PieceMove&
+  back() noexcept;
+
+  //! @return A const reference to the last move in the list.
+  //! @throw Never throws.
+  const PieceMove&
+  back() const noexcept;
+
+  //! @param index The index of a move in the list.
+  //! @return A reference to the move.
+  //! @throw Never throws.
+  PieceMove&
+  operator[](size_type index) noexcept;
+
+  //! @param index The index of a move in the list.
+  //! @return A const reference to the move.
+  //! @throw Never throws.
+  const PieceMove&
+  operator[](size_type index) const noexcept;
+
+  //! @return An iterator to the first move.
+  //! @throw Never throws.
+  iterator
+  begin() noexcept;
+
+  //! @return An iterator to one past the last move.
+  //! @throw Never throws.
+  iterator
+  end() noexcept;
+
+  //! @return A const iterator to the first move.
+  //! @throw Never throws.
+  const_iterator
+  begin() const noexcept;
+
+  //! @return A const iterator to one past the last move.
+  //! @throw Never throws.
+  const_iterator
+  end() const noexcept;
+
+private:
+  // Raw storage for a move, which is only constructed when it is added.
+  using storage_type =
+    std::aligned_storage<sizeof(PieceMove), alignof(PieceMove)>::type;
+
+  // Moves do not need to be destroyed when they are removed.
+  static_assert(std::is_trivially_destructible<PieceMove>::value,
+                "PieceMove must be trivially destructible");
+
+  // The moves.
+  storage_type mMoves[CAPACITY];
+
+  // The number of moves in the list.
+  size_type mSize;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// default ctor
+//
+inline
+MoveList::MoveList() noexcept
+  : mSize(0) {}
+
+//
+// construct a move at the end of the list
+//
+template<typename... Args>
+inline PieceMove&
+MoveList::emplace_back(Args&&... args) noexcept
+{
+  assert(mSize < CAPACITY);
+  auto pMove = new (&mMoves[mSize]) PieceMove(std::forward<Args>(args)...);
+  ++mSize;
+  return *pMove;
+}
+
+//
+// copy a move to the end of the list
+//
+inline void
+MoveList::push_back(const PieceMove &pMove) noexcept
+{
+  emplace_back(pMove);
+}
+
+//
+// remove the last move
+//
+inline void
+MoveList::pop_back() noexcept
+{
+  assert(mSize > 0);
+  --mSize;
+}
+
+//
+// remove all the moves
+//
+inline void
+MoveList::clear() noexcept
+{
+  mSize = 0;
+}
+
+//
+// number of moves
+//
+inline MoveList::size_type
+MoveList::size() const noexcept
+{
+  return mSize;
+}
+
+//
+// check if there are no moves
+//
+inline bool
+MoveList::empty() const noexcept
+{
+  return mSize == 0;
+}
+
+//
+// last move
+//
+inline PieceMove&
+MoveList::back() noexcept
+{
+  assert(mSize > 0);
+  return begin()[mSize-1];
+}
+
+//
+// last move, const version
+//
+inline const PieceMove&
+MoveList::back() const noexcept
+{
+  assert(mSize > 0);
+  return begin()[mSize-1];
+}
+
+//
+// access a move by index
+//
+inline PieceMove&
+MoveList::operator[](size_type index) noexcept
+{
+  assert(index < mSize);
+  return begin()[index];
+}
+
+//
+// access a move by index, const version
+//
+inline const PieceMove&
+MoveList::operator[](size_type index) const noexcept
+{
+  assert(index < mSize);
+  return begin()[index];
+}
+
+//
+// iterator to the first move
+//
+inline MoveList::iterator
+MoveList::begin() noexcept
+{
+  return reinterpret_cast<PieceMove*>(&mMoves[0]);
+}
+
+//
+// iterator to one past the last move
+//
+inline MoveList::iterator
+MoveList::end() noexcept
+{
+  return begin() + mSize;
+}
+
+//
+// const iterator to the first move
+//
+inline MoveList::const_iterator
+MoveList::begin() const noexcept
+{
+  return reinterpret_cast<const PieceMove*>(&mMoves[0]);
+}
+
+//
+// const iterator to one past the last move
+//
+inline MoveList::const_iterator
+MoveList::end() const noexcept
+{
+  return begin() + mSize;
+}
+
+} // namespace zoor
+#endif // _MOVELIST_H
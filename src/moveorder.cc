@@ -0,0 +1,126 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file moveorder.cc
+//! @author Omar A Serrano
+//! @date 2016-10-16
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <algorithm>
+#include <cstdlib>
+
+//
+// zoor
+//
+#include "bitboard.hh"
+#include "moveorder.hh"
+
+namespace zoor {
+
+//
+// init static vars
+//
+const int MoveOrder::HISTORY_MAX;
+
+//
+// default ctor
+//
+MoveOrder::MoveOrder() noexcept
+{
+  clear();
+}
+
+//
+// empty the tables
+//
+void
+MoveOrder::clear() noexcept
+{
+  for (auto &plyKillers : mKillers)
+    std::fill(std::begin(plyKillers), std::end(plyKillers), PackedMove());
+  std::fill(&mHistory[0][0][0], &mHistory[0][0][0] + 2*64*64, 0);
+  std::fill(&mCounterMoves[0][0][0], &mCounterMoves[0][0][0] + 2*8*64,
+            PackedMove());
+}
+
+//
+// most valuable victim, then least valuable attacker
+//
+int
+MoveOrder::mvvLva(const PieceMove &pMove) noexcept
+{
+  int score = 8 * static_cast<int>(pMove.xPiece());
+  if (pMove.isPromo())
+    score += 8 * static_cast<int>(pMove.dPiece());
+  return score - static_cast<int>(pMove.sPiece());
+}
+
+//
+// add a killer move
+//
+void
+MoveOrder::addKiller(int ply, const PieceMove &pMove) noexcept
+{
+  assert(ply >= 0 and ply < MAX_PLY);
+  PackedMove packed(pMove);
+  auto &plyKillers = mKillers[ply];
+  if (plyKillers[0] == packed)
+    return;
+  std::copy_backward(plyKillers, plyKillers + KILLERS - 1,
+                     plyKillers + KILLERS);
+  plyKillers[0] = packed;
+}
+
+//
+// the history score of a move
+//
+int
+MoveOrder::history(const PieceMove &pMove) const noexcept
+{
+  auto from = squareIndex(pMove.sRow(), pMove.sColumn());
+  auto to = squareIndex(pMove.dRow(), pMove.dColumn());
+  return mHistory[colorIndex(pMove.sColor())][from][to];
+}
+
+//
+// change the history score of a move
+//
+void
+MoveOrder::addHistory(const PieceMove &pMove, int bonus) noexcept
+{
+  bonus = std::max(-HISTORY_MAX, std::min(bonus, HISTORY_MAX));
+  auto from = squareIndex(pMove.sRow(), pMove.sColumn());
+  auto to = squareIndex(pMove.dRow(), pMove.dColumn());
+  auto &score = mHistory[colorIndex(pMove.sColor())][from][to];
+  score += bonus - score * std::abs(bonus) / HISTORY_MAX;
+}
+
+//
+// the countermove of a move
+//
+PackedMove
+MoveOrder::counterMove(const PieceMove &lastMove) const noexcept
+{
+  if (notPiece(lastMove.sPiece()))
+    return PackedMove();
+  auto to = squareIndex(lastMove.dRow(), lastMove.dColumn());
+  auto piece = static_cast<int>(lastMove.sPiece());
+  return mCounterMoves[colorIndex(lastMove.sColor())][piece][to];
+}
+
+//
+// set the countermove of a move
+//
+void
+MoveOrder::setCounterMove(const PieceMove &lastMove,
+                          const PieceMove &pMove) noexcept
+{
+  if (notPiece(lastMove.sPiece()))
+    return;
+  auto to = squareIndex(lastMove.dRow(), lastMove.dColumn());
+  auto piece = static_cast<int>(lastMove.sPiece());
+  mCounterMoves[colorIndex(lastMove.sColor())][piece][to] = PackedMove(pMove);
+}
+
+} // namespace zoor
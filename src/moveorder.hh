@@ -0,0 +1,145 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file moveorder.hh
+//! @author Omar A Serrano
+//! @date 2016-10-16
+//! @details The tables that a search fills to order the moves of the positions
+//! it visits, so that the moves most likely to cause a cutoff are searched
+//! first:
+//! @li Captures are ordered by the most valuable victim, and then by the least
+//! valuable attacker (MVV-LVA), which needs no table.
+//! @li The killer moves of a ply are the last two quiet moves that caused a
+//! cutoff at the same ply, in any position.
+//! @li The history of a quiet move, indexed by the color that makes it and by
+//! the squares it moves from and to, grows when the move causes a cutoff and
+//! shrinks when another move does.
+//! @li The countermove of a move is the quiet move that last caused a cutoff
+//! in reply to it, indexed by the piece that moved and the square it moved to.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _MOVEORDER_H
+#define _MOVEORDER_H
+
+//
+// STL
+//
+#include <cassert>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "packedmove.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief The move ordering tables of a search.
+//! @details The tables are large, so a @c MoveOrder is meant to live as long
+//! as the search that fills it.
+class MoveOrder
+{
+public:
+  //! @brief The number of plies with killer moves.
+  enum { MAX_PLY = 64 };
+
+  //! @brief The number of killer moves of a ply.
+  enum { KILLERS = 2 };
+
+  //! @brief The largest magnitude of a history score.
+  static const int HISTORY_MAX = 16384;
+
+  //! @brief Constructor, with empty tables.
+  //! @throw Never throws.
+  MoveOrder() noexcept;
+
+  //! @brief Empty the tables.
+  //! @throw Never throws.
+  void
+  clear() noexcept;
+
+  //! @brief The score of a capture or promotion.
+  //! @details Higher for a more valuable victim, or for a more valuable
+  //! promotion piece, and then for a less valuable attacker.
+  //! @param pMove The @c PieceMove.
+  //! @return The score of the move.
+  //! @throw Never throws.
+  static int
+  mvvLva(const PieceMove &pMove) noexcept;
+
+  //! @param ply The ply.
+  //! @param index The index of the killer move, 0 for the most recent.
+  //! @return The killer move, or a null move.
+  //! @throw Never throws.
+  PackedMove
+  killer(int ply, int index) const noexcept;
+
+  //! @brief Add a killer move to a ply.
+  //! @details The oldest killer of the ply is dropped, unless the move is
+  //! already the most recent killer.
+  //! @param ply The ply.
+  //! @param pMove The quiet move that caused a cutoff.
+  //! @throw Never throws.
+  void
+  addKiller(int ply, const PieceMove &pMove) noexcept;
+
+  //! @param pMove The @c PieceMove.
+  //! @return The history score of the move.
+  //! @throw Never throws.
+  int
+  history(const PieceMove &pMove) const noexcept;
+
+  //! @brief Change the history score of a move.
+  //! @details The score moves towards HISTORY_MAX for a positive bonus, or
+  //! towards -HISTORY_MAX for a negative one, by less the closer it is, so it
+  //! never goes past them.
+  //! @param pMove The @c PieceMove.
+  //! @param bonus The change, which should be between -HISTORY_MAX and
+  //! HISTORY_MAX.
+  //! @throw Never throws.
+  void
+  addHistory(const PieceMove &pMove, int bonus) noexcept;
+
+  //! @param lastMove The move made before the position.
+  //! @return The countermove of the move, or a null move.
+  //! @throw Never throws.
+  PackedMove
+  counterMove(const PieceMove &lastMove) const noexcept;
+
+  //! @brief Set the countermove of a move.
+  //! @param lastMove The move made before the position.
+  //! @param pMove The quiet move that caused a cutoff in reply.
+  //! @throw Never throws.
+  void
+  setCounterMove(const PieceMove &lastMove, const PieceMove &pMove) noexcept;
+
+private:
+  // The killer moves, indexed by ply.
+  PackedMove mKillers[MAX_PLY][KILLERS];
+
+  // The history scores, indexed by color, and the squares moved from and to.
+  int mHistory[2][64][64];
+
+  // The countermoves, indexed by color, piece, and the square moved to.
+  PackedMove mCounterMoves[2][8][64];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// a killer move of a ply
+//
+inline PackedMove
+MoveOrder::killer(int ply, int index) const noexcept
+{
+  assert(ply >= 0 and ply < MAX_PLY);
+  assert(index >= 0 and index < KILLERS);
+  return mKillers[ply][index];
+}
+
+} // namespace zoor
+#endif // _MOVEORDER_H
@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file movepicker.cc
+//! @author Omar A Serrano
+//! @date 2016-10-16
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "movepicker.hh"
+#include "moveorder.hh"
+
+namespace zoor {
+
+//
+// constructor without killers
+//
+MovePicker::MovePicker(const Board &board, PackedMove tableMove) noexcept
+  : mBoard(board),
+    mTableMove(tableMove),
+    mOrder(nullptr),
+    mIndex(0),
+    mStage(Stage::TABLE),
+    mCapturesOnly(false) {}
+
+//
+// constructor
+//
+MovePicker::MovePicker(const Board &board,
+                       PackedMove tableMove,
+                       const PackedMove (&killers)[KILLERS]) noexcept
+  : MovePicker(board, tableMove)
+{
+  std::copy(std::begin(killers), std::end(killers), mKillers);
+}
+
+//
+// constructor with the move ordering tables
+//
+MovePicker::MovePicker(const Board &board,
+                       PackedMove tableMove,
+                       const MoveOrder &order,
+                       int ply) noexcept
+  : MovePicker(board, tableMove)
+{
+  mOrder = &order;
+  for (int i = 0; i < KILLERS; ++i)
+    mKillers[i] = order.killer(ply, i);
+  mCounterMove = order.counterMove(board.lastMove());
+}
+
+//
+// constructor for the captures only, or the evasions of a check
+//
+MovePicker::MovePicker(const Board &board) noexcept
+  : MovePicker(board, PackedMove())
+{
+  if (not board.inCheck()) {
+    mStage = Stage::CAPTURES_INIT;
+    mCapturesOnly = true;
+  }
+}
+
+//
+// a selection sort, one move at a time, which stops early if there is a cutoff
+//
+template<typename Score>
+void
+MovePicker::selectBest(Score score) noexcept
+{
+  auto best = mIndex;
+  auto bestScore = score(mMoves[best]);
+  for (auto i = mIndex + 1; i < mMoves.size(); ++i) {
+    auto value = score(mMoves[i]);
+    if (value > bestScore) {
+      best = i;
+      bestScore = value;
+    }
+  }
+  std::swap(mMoves[mIndex], mMoves[best]);
+}
+
+//
+// the next move
+//
+bool
+MovePicker::next(PieceMove &pMove) noexcept
+{
+  switch (mStage) {
+  case Stage::TABLE:
+    mStage = Stage::CAPTURES_INIT;
+    if (not mTableMove.isNull()) {
+      pMove = mTableMove.toPieceMove();
+      if (mBoard.isLegal(pMove))
+        return true;
+    }
+    // fall through
+
+  case Stage::CAPTURES_INIT:
+    mBoard.getLegalMoves(mMoves, Board::GenType::CAPTURES);
+    mIndex = 0;
+    mStage = Stage::CAPTURES;
+    // fall through
+
+  case Stage::CAPTURES:
+    while (mIndex < mMoves.size()) {
+      selectBest(MoveOrder::mvvLva);
+      pMove = mMoves[mIndex++];
+      if (PackedMove(pMove) != mTableMove)
+        return true;
+    }
+    if (mCapturesOnly) {
+      mStage = Stage::DONE;
+      break;
+    }
+    mIndex = 0;
+    mStage = Stage::KILLERS;
+    // fall through
+
+  case Stage::KILLERS:
+    while (mIndex < KILLERS) {
+      auto killer = mKillers[mIndex];
+      bool picked = killer == mTableMove
+        or std::find(mKillers, mKillers + mIndex, killer) != mKillers + mIndex;
+      ++mIndex;
+      if (not picked and isLegalQuiet(killer, pMove))
+        return true;
+    }
+    mStage = Stage::COUNTER;
+    // fall through
+
+  case Stage::COUNTER:
+    mStage = Stage::QUIETS_INIT;
+    if (mCounterMove != mTableMove
+        and std::find(std::begin(mKillers), std::end(mKillers), mCounterMove)
+            == std::end(mKillers)
+        and isLegalQuiet(mCounterMove, pMove))
+      return true;
+    // fall through
+
+  case Stage::QUIETS_INIT:
+    mMoves.clear();
+    mBoard.getLegalMoves(mMoves, Board::GenType::QUIETS);
+    mIndex = 0;
+    mStage = Stage::QUIETS;
+    // fall through
+
+  case Stage::QUIETS:
+    while (mIndex < mMoves.size()) {
+      if (mOrder)
+        selectBest([this](const PieceMove &pm) { return mOrder->history(pm); });
+      pMove = mMoves[mIndex++];
+      if (not isPicked(PackedMove(pMove)))
+        return true;
+    }
+    mStage = Stage::DONE;
+    // fall through
+
+  case Stage::DONE:
+    break;
+  }
+
+  return false;
+}
+
+//
+// check for a legal quiet move
+//
+bool
+MovePicker::isLegalQuiet(PackedMove packed, PieceMove &pMove) const noexcept
+{
+  if (packed.isNull())
+    return false;
+  pMove = packed.toPieceMove();
+  return not pMove.isCapture() and not pMove.isPromo()
+     and mBoard.isLegal(pMove);
+}
+
+//
+// check if the move was picked before the quiet moves
+//
+bool
+MovePicker::isPicked(PackedMove packed) const noexcept
+{
+  return packed == mTableMove or packed == mCounterMove
+      or std::find(std::begin(mKillers), std::end(mKillers), packed)
+         != std::end(mKillers);
+}
+
+} // namespace zoor
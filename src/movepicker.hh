@@ -0,0 +1,153 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file movepicker.hh
+//! @author Omar A Serrano
+//! @date 2016-10-16
+//! @details A staged move generator. Most nodes of an alpha-beta search are
+//! cut off by one of the first moves searched, so the moves of a position are
+//! generated in stages, each one when the stage before it runs out:
+//! @li The move from the transposition table, if it is legal.
+//! @li Captures and promotions, the most valuable victim first, and of those
+//! the least valuable attacker first.
+//! @li The killer moves, if they are legal quiet moves.
+//! @li The countermove of the last move, if it is a legal quiet move.
+//! @li The other quiet moves, with the best history score first.
+//!
+//! The killer moves, the countermove, and the history scores come from the
+//! @c MoveOrder of the search, if it is given.
+//!
+//! No move is returned twice, and every move returned is legal. A picker for
+//! a quiescence search stops after the captures and promotions, unless the
+//! player to move is in check.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _MOVEPICKER_H
+#define _MOVEPICKER_H
+
+//
+// STL
+//
+#include <cstddef>
+
+//
+// zoor
+//
+#include "movelist.hh"
+#include "moveorder.hh"
+#include "packedmove.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+// Forward declarations.
+class Board;
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Picks the moves of a position one at a time, in stages.
+//! @details The board must not change while the moves are picked, but moves
+//! may be made and taken back between calls to next().
+class MovePicker
+{
+public:
+  //! @brief The number of killer moves.
+  enum { KILLERS = MoveOrder::KILLERS };
+
+  //! @brief Constructor without killer moves.
+  //! @param board The @c Board with the position.
+  //! @param tableMove The move from the transposition table, or a null move.
+  //! @throw Never throws.
+  MovePicker(const Board &board, PackedMove tableMove) noexcept;
+
+  //! @brief Constructor.
+  //! @param board The @c Board with the position.
+  //! @param tableMove The move from the transposition table, or a null move.
+  //! @param killers The killer moves, which may be null moves.
+  //! @throw Never throws.
+  MovePicker(const Board &board,
+             PackedMove tableMove,
+             const PackedMove (&killers)[KILLERS]) noexcept;
+
+  //! @brief Constructor with the move ordering tables of a search.
+  //! @param board The @c Board with the position.
+  //! @param tableMove The move from the transposition table, or a null move.
+  //! @param order The move ordering tables.
+  //! @param ply The ply of the position in the search.
+  //! @throw Never throws.
+  MovePicker(const Board &board,
+             PackedMove tableMove,
+             const MoveOrder &order,
+             int ply) noexcept;
+
+  //! @brief Constructor for the captures and promotions only.
+  //! @details For a quiescence search, which never generates the quiet moves,
+  //! unless the player to move is in check, when every evasion is picked.
+  //! @param board The @c Board with the position.
+  //! @throw Never throws.
+  explicit
+  MovePicker(const Board &board) noexcept;
+
+  //! @brief Get the next move.
+  //! @param pMove Set to the next move, if there is one.
+  //! @return False if there are no more moves.
+  //! @throw Never throws.
+  bool
+  next(PieceMove &pMove) noexcept;
+
+private:
+  // The stages, in the order in which they are picked.
+  enum class Stage
+  {
+    TABLE,
+    CAPTURES_INIT,
+    CAPTURES,
+    KILLERS,
+    COUNTER,
+    QUIETS_INIT,
+    QUIETS,
+    DONE
+  };
+
+  // True if the move is a legal quiet move, which is unpacked to pMove.
+  bool
+  isLegalQuiet(PackedMove packed, PieceMove &pMove) const noexcept;
+
+  // True if the move is one of the moves before the quiet moves.
+  bool
+  isPicked(PackedMove packed) const noexcept;
+
+  // Move the best move left, by the score, to the next index.
+  template<typename Score>
+  void
+  selectBest(Score score) noexcept;
+
+  // The board with the position.
+  const Board &mBoard;
+
+  // The move from the transposition table.
+  PackedMove mTableMove;
+
+  // The killer moves.
+  PackedMove mKillers[KILLERS];
+
+  // The countermove of the last move.
+  PackedMove mCounterMove;
+
+  // The move ordering tables, if any.
+  const MoveOrder *mOrder;
+
+  // The moves of the current stage.
+  MoveList mMoves;
+
+  // The index of the next move in mMoves, or of the next killer.
+  size_t mIndex;
+
+  // The current stage.
+  Stage mStage;
+
+  // True if the quiet moves are left out.
+  bool mCapturesOnly;
+};
+
+} // namespace zoor
+#endif // _MOVEPICKER_H
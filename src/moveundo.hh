@@ -0,0 +1,50 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file moveundo.hh
+//! @author Omar A Serrano
+//! @date 2016-10-09
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _MOVEUNDO_H
+#define _MOVEUNDO_H
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "bitboard.hh"
+#include "boardinfo.hh"
+#include "piecemove.hh"
+#include "psqt.hh"
+#include "zobrist.hh"
+
+namespace zoor {
+
+//! @brief The state of a @c Board that cannot be recovered from the move that
+//! was made, saved before the move so that it can be taken back.
+//! @details Filled in by Board::makeMove(const PieceMove&, MoveUndo&) and
+//! consumed by Board::unmakeMove(), which restores the board to the position
+//! it had before the move. The move itself is not saved, because it becomes
+//! the last move of the board.
+struct MoveUndo
+{
+  //! @brief The last move before the move was made.
+  PieceMove lastMove;
+
+  //! @brief The king info before the move was made.
+  BoardInfo info;
+
+  //! @brief The hash of the board before the move was made.
+  Zobrist::key_type hash;
+
+  //! @brief The piece-square sums of the board before the move was made.
+  PsqtScore psqt;
+
+  //! @brief The pieces giving check before the move was made.
+  bitboard_t checkers;
+
+  //! @brief The piece captured by the move, or a code without a piece if the
+  //! move was not a capture.
+  piece_t captured;
+};
+
+} // namespace zoor
+#endif // _MOVEUNDO_H
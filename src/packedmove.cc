@@ -0,0 +1,101 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file packedmove.cc
+//! @author Omar A Serrano
+//! @date 2016-10-10
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <ostream>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "packedmove.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+//
+// construct from a PieceMove
+//
+PackedMove::PackedMove(const PieceMove &pMove) noexcept
+  : mData(0)
+{
+  if (notPiece(pMove.sPiece()))
+    return;
+
+  data_type flag = FLAG_NONE;
+  data_type captured = 0;
+  data_type promo = 0;
+
+  if (pMove.isCastle())
+    flag = FLAG_CASTLE;
+  else if (pMove.isCastleLong())
+    flag = FLAG_CASTLE_LONG;
+  else if (pMove.isCapture()) {
+    captured = static_cast<data_type>(pMove.xPiece());
+    if (pMove.isEnPassant())
+      flag = FLAG_EN_PASSANT;
+  }
+
+  if (pMove.isPromo())
+    promo = static_cast<data_type>(pMove.dPiece());
+
+  auto from = static_cast<data_type>(pMove.sRow() * 8 + pMove.sColumn());
+  auto to = static_cast<data_type>(pMove.dRow() * 8 + pMove.dColumn());
+
+  mData = from << FROM_SHIFT
+        | to << TO_SHIFT
+        | static_cast<data_type>(pMove.sPiece()) << PIECE_SHIFT
+        | captured << CAPTURED_SHIFT
+        | promo << PROMO_SHIFT
+        | data_type(isBlack(pMove.sColor()) ? 1 : 0) << BLACK_SHIFT
+        | flag << FLAG_SHIFT;
+}
+
+//
+// convert to a PieceMove
+//
+PieceMove
+PackedMove::toPieceMove() const noexcept
+{
+  if (isNull())
+    return PieceMove();
+
+  auto color = this->color();
+  dim_t fromRow = from() / 8;
+  dim_t fromCol = from() % 8;
+  dim_t toRow = to() / 8;
+  dim_t toCol = to() % 8;
+
+  PieceMove pMove(fromRow, fromCol, color | piece(), toRow, toCol);
+
+  if (isPromo())
+    pMove.dPiece(promo(), color);
+
+  if (isCastle())
+    pMove.xPiece(fromRow, 7, Piece::R, color);
+  else if (isCastleLong())
+    pMove.xPiece(fromRow, 0, Piece::R, color);
+  else if (isEnPassant())
+    pMove.xPiece(fromRow, toCol, captured(), ~color);
+  else if (isCapture())
+    pMove.xPiece(toRow, toCol, captured(), ~color);
+
+  return pMove;
+}
+
+//
+// output stream
+//
+std::ostream&
+operator<<(std::ostream &os, const PackedMove &pm)
+{
+  os << pm.toPieceMove();
+  return os;
+}
+
+} // namespace zoor
@@ -0,0 +1,380 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file packedmove.hh
+//! @author Omar A Serrano
+//! @date 2016-10-10
+//! @details A @c PackedMove holds the same information as a @c PieceMove in a
+//! single 32 bit word, with the following layout:
+//! @li bits 0 to 5: the index of the square the piece moves from.
+//! @li bits 6 to 11: the index of the square the piece moves to.
+//! @li bits 12 to 14: the piece that moves.
+//! @li bits 15 to 17: the captured piece, if any.
+//! @li bits 18 to 20: the promotion piece, if any.
+//! @li bit 21: set if the piece that moves is black.
+//! @li bits 22 and 23: castling, long castling, or en passant.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _PACKEDMOVE_H
+#define _PACKEDMOVE_H
+
+//
+// STL
+//
+#include <cstdint>
+#include <functional>
+#include <ostream>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief A move packed in 32 bits.
+//! @details Meant to be stored where space matters, for example in killer
+//! tables or in the transposition table. A @c PackedMove converts to and from
+//! a @c PieceMove without losing any information, as long as the
+//! @c PieceMove was created by @c Board.
+class PackedMove
+{
+public:
+  //! @brief Alias for the underlying type.
+  using data_type = uint32_t;
+
+  //! @brief Default ctor.
+  //! @details Initializes a null move, which converts to a default
+  //! constructed @c PieceMove.
+  //! @throw Never throws.
+  PackedMove() noexcept;
+
+  //! @brief Construct from a @c PieceMove.
+  //! @param pMove The @c PieceMove.
+  //! @throw Never throws.
+  explicit PackedMove(const PieceMove &pMove) noexcept;
+
+  //! @brief Construct from the raw bits of another @c PackedMove.
+  //! @param data The raw bits, as returned by data().
+  //! @return The @c PackedMove.
+  //! @throw Never throws.
+  static PackedMove
+  fromData(data_type data) noexcept;
+
+  //! @return The raw bits of the move.
+  //! @throw Never throws.
+  data_type
+  data() const noexcept;
+
+  //! @return The @c PieceMove with the same information.
+  //! @throw Never throws.
+  PieceMove
+  toPieceMove() const noexcept;
+
+  //! @return True if this is the null move.
+  //! @throw Never throws.
+  bool
+  isNull() const noexcept;
+
+  //! @return The index of the square the piece moves from.
+  //! @throw Never throws.
+  dim_t
+  from() const noexcept;
+
+  //! @return The index of the square the piece moves to.
+  //! @throw Never throws.
+  dim_t
+  to() const noexcept;
+
+  //! @return The piece that moves.
+  //! @throw Never throws.
+  Piece
+  piece() const noexcept;
+
+  //! @return The color of the piece that moves.
+  //! @throw Never throws.
+  Color
+  color() const noexcept;
+
+  //! @return The captured piece, or Piece::NONE if it is not a capture.
+  //! @throw Never throws.
+  Piece
+  captured() const noexcept;
+
+  //! @return The promotion piece, or Piece::NONE if it is not a promotion.
+  //! @throw Never throws.
+  Piece
+  promo() const noexcept;
+
+  //! @return True if the move is a capture.
+  //! @throw Never throws.
+  bool
+  isCapture() const noexcept;
+
+  //! @return True if the move is a pawn promotion.
+  //! @throw Never throws.
+  bool
+  isPromo() const noexcept;
+
+  //! @return True if the move represents short castling.
+  //! @throw Never throws.
+  bool
+  isCastle() const noexcept;
+
+  //! @return True if the move represents long castling.
+  //! @throw Never throws.
+  bool
+  isCastleLong() const noexcept;
+
+  //! @return True if the move represents en passant.
+  //! @throw Never throws.
+  bool
+  isEnPassant() const noexcept;
+
+private:
+  // Shifts and masks of the fields.
+  enum : data_type {
+    FROM_SHIFT = 0,
+    TO_SHIFT = 6,
+    PIECE_SHIFT = 12,
+    CAPTURED_SHIFT = 15,
+    PROMO_SHIFT = 18,
+    BLACK_SHIFT = 21,
+    FLAG_SHIFT = 22,
+    SQUARE_MASK = 0x3f,
+    PIECE_MASK = 0x7,
+    FLAG_MASK = 0x3
+  };
+
+  // Values of the flag field.
+  enum : data_type {
+    FLAG_NONE,
+    FLAG_CASTLE,
+    FLAG_CASTLE_LONG,
+    FLAG_EN_PASSANT
+  };
+
+  // Get a field.
+  data_type
+  field(data_type shift, data_type mask) const noexcept;
+
+  // The bits of the move.
+  data_type mData;
+};
+
+//! @brief Equality operator for @c PackedMove.
+//! @param pm1 The first @c PackedMove.
+//! @param pm2 The second @c PackedMove.
+//! @return True if the moves are equal, false otherwise.
+//! @throw Never throws.
+bool
+operator==(const PackedMove &pm1, const PackedMove &pm2) noexcept;
+
+//! @brief Non-equality operator for @c PackedMove.
+//! @param pm1 The first @c PackedMove.
+//! @param pm2 The second @c PackedMove.
+//! @return True if the moves are not equal, false otherwise.
+//! @throw Never throws.
+bool
+operator!=(const PackedMove &pm1, const PackedMove &pm2) noexcept;
+
+//! @brief Output operator for @c PackedMove.
+//! @details Writes the move in the same format as the @c PieceMove.
+//! @param os A reference to the output stream.
+//! @param pm The @c PackedMove.
+//! @return A reference to the output stream.
+std::ostream&
+operator<<(std::ostream &os, const PackedMove &pm);
+
+static_assert(sizeof(PackedMove) == 4, "PackedMove must fit in 32 bits");
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// default ctor
+//
+inline
+PackedMove::PackedMove() noexcept
+  : mData(0) {}
+
+//
+// construct from raw bits
+//
+inline PackedMove
+PackedMove::fromData(data_type data) noexcept
+{
+  PackedMove pm;
+  pm.mData = data;
+  return pm;
+}
+
+//
+// raw bits
+//
+inline PackedMove::data_type
+PackedMove::data() const noexcept
+{
+  return mData;
+}
+
+//
+// check for the null move
+//
+inline bool
+PackedMove::isNull() const noexcept
+{
+  return mData == 0;
+}
+
+//
+// square moving from
+//
+inline dim_t
+PackedMove::from() const noexcept
+{
+  return static_cast<dim_t>(field(FROM_SHIFT, SQUARE_MASK));
+}
+
+//
+// square moving to
+//
+inline dim_t
+PackedMove::to() const noexcept
+{
+  return static_cast<dim_t>(field(TO_SHIFT, SQUARE_MASK));
+}
+
+//
+// piece moving
+//
+inline Piece
+PackedMove::piece() const noexcept
+{
+  return static_cast<Piece>(field(PIECE_SHIFT, PIECE_MASK));
+}
+
+//
+// color of the piece moving
+//
+inline Color
+PackedMove::color() const noexcept
+{
+  if (isNull())
+    return Color::NONE;
+  return field(BLACK_SHIFT, 1) ? Color::B : Color::W;
+}
+
+//
+// captured piece
+//
+inline Piece
+PackedMove::captured() const noexcept
+{
+  return static_cast<Piece>(field(CAPTURED_SHIFT, PIECE_MASK));
+}
+
+//
+// promotion piece
+//
+inline Piece
+PackedMove::promo() const noexcept
+{
+  return static_cast<Piece>(field(PROMO_SHIFT, PIECE_MASK));
+}
+
+//
+// check for capture
+//
+inline bool
+PackedMove::isCapture() const noexcept
+{
+  return field(CAPTURED_SHIFT, PIECE_MASK) != 0;
+}
+
+//
+// check for promotion
+//
+inline bool
+PackedMove::isPromo() const noexcept
+{
+  return field(PROMO_SHIFT, PIECE_MASK) != 0;
+}
+
+//
+// check for short castling
+//
+inline bool
+PackedMove::isCastle() const noexcept
+{
+  return field(FLAG_SHIFT, FLAG_MASK) == FLAG_CASTLE;
+}
+
+//
+// check for long castling
+//
+inline bool
+PackedMove::isCastleLong() const noexcept
+{
+  return field(FLAG_SHIFT, FLAG_MASK) == FLAG_CASTLE_LONG;
+}
+
+//
+// check for en passant
+//
+inline bool
+PackedMove::isEnPassant() const noexcept
+{
+  return field(FLAG_SHIFT, FLAG_MASK) == FLAG_EN_PASSANT;
+}
+
+//
+// get a field
+//
+inline PackedMove::data_type
+PackedMove::field(data_type shift, data_type mask) const noexcept
+{
+  return (mData >> shift) & mask;
+}
+
+//
+// are moves equal
+//
+inline bool
+operator==(const PackedMove &pm1, const PackedMove &pm2) noexcept
+{
+  return pm1.data() == pm2.data();
+}
+
+//
+// are moves not equal
+//
+inline bool
+operator!=(const PackedMove &pm1, const PackedMove &pm2) noexcept
+{
+  return not (pm1 == pm2);
+}
+
+} // namespace zoor
+
+namespace std {
+
+//! @brief PackedMove specialization for <em>hash</em>.
+template<>
+struct hash<zoor::PackedMove>
+{
+  using argument_type = zoor::PackedMove;
+  using result_type = size_t;
+
+  result_type
+  operator()(const argument_type& arg) const noexcept
+  {
+    return static_cast<result_type>(arg.data());
+  }
+};
+
+} // std
+#endif // _PACKEDMOVE_H
@@ -0,0 +1,138 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file parallelperft.cc
+//! @author Omar A Serrano
+//! @date 2016-10-25
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <system_error>
+#include <thread>
+#include <utility>
+#include <vector>
+
+//
+// zoor
+//
+#include "board.hh"
+#include "movelist.hh"
+#include "moveundo.hh"
+#include "parallelperft.hh"
+#include "perft.hh"
+#include "perfttable.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+namespace {
+
+//
+// a subtree counted by one thread: the tree below a root move, or below a
+// reply to a root move
+//
+struct Task
+{
+  size_t root;
+  PieceMove reply;
+  bool hasReply;
+  node_t nodes;
+};
+
+} // namespace
+
+//
+// constructor
+//
+ParallelPerft::ParallelPerft(PerftTable &table, unsigned threads) noexcept
+  : mTable(table),
+    mThreads(std::max(threads, 1u)) {}
+
+//
+// count the leaf nodes
+//
+node_t
+ParallelPerft::run(const Board &board, int depth)
+{
+  if (depth <= 0)
+    return 1;
+
+  node_t nodes = 0;
+  for (auto &moveCount : divide(board, depth))
+    nodes += moveCount.second;
+  return nodes;
+}
+
+//
+// count the leaf nodes below each move
+//
+std::vector<std::pair<PieceMove, node_t>>
+ParallelPerft::divide(const Board &board, int depth)
+{
+  assert(depth > 0);
+
+  MoveList rootMoves;
+  board.getLegalMoves(rootMoves);
+
+  // split the tree at the second move, if there is a tree below it
+  std::vector<Task> tasks;
+  Board scratch(board);
+  for (size_t i = 0; i < rootMoves.size(); ++i) {
+    if (depth < 3) {
+      tasks.push_back({i, PieceMove(), false, 0});
+      continue;
+    }
+    MoveUndo undo;
+    scratch.makeMove(rootMoves[i], undo);
+    MoveList replies;
+    scratch.getLegalMoves(replies);
+    for (auto &pm : replies)
+      tasks.push_back({i, pm, true, 0});
+    scratch.unmakeMove(undo);
+  }
+
+  // each thread takes the next task until there are none left
+  std::atomic<size_t> next(0);
+  auto work = [this, &board, &rootMoves, &tasks, &next, depth] {
+    Board b(board);
+    for (auto i = next++; i < tasks.size(); i = next++) {
+      auto &task = tasks[i];
+      MoveUndo rootUndo, replyUndo;
+      b.makeMove(rootMoves[task.root], rootUndo);
+      if (task.hasReply) {
+        b.makeMove(task.reply, replyUndo);
+        task.nodes = perft(b, depth - 2, mTable);
+        b.unmakeMove(replyUndo);
+      } else
+        task.nodes = perft(b, depth - 1, mTable);
+      b.unmakeMove(rootUndo);
+    }
+  };
+
+  // the calling thread works too, so the count is finished even if some
+  // threads cannot be started
+  std::vector<std::thread> helpers;
+  try {
+    for (unsigned i = 1; i < mThreads; ++i)
+      helpers.emplace_back(work);
+  } catch (const std::system_error&) {
+  }
+  work();
+  for (auto &helper : helpers)
+    helper.join();
+
+  // add the counts of the replies of each root move
+  std::vector<std::pair<PieceMove, node_t>> divideList;
+  for (auto &pm : rootMoves)
+    divideList.emplace_back(pm, 0);
+  for (auto &task : tasks)
+    divideList[task.root].second += task.nodes;
+
+  return divideList;
+}
+
+} // namespace zoor
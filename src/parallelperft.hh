@@ -0,0 +1,89 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file parallelperft.hh
+//! @author Omar A Serrano
+//! @date 2016-10-25
+//! @details Perft with several threads. The tree is split into one task for
+//! each move of the root, or for each pair of a root move and a reply when
+//! the tree is at least three moves deep, so that there are many more tasks
+//! than threads and the threads finish at about the same time. The threads
+//! take the tasks in order from a shared counter, each on its own copy of the
+//! board, and share a @c PerftTable, so that a position counted by one thread
+//! is not counted again by another.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _PARALLELPERFT_H
+#define _PARALLELPERFT_H
+
+//
+// STL
+//
+#include <utility>
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+// Forward declarations.
+class Board;
+class PerftTable;
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Counts the leaf nodes of the tree of legal moves with several
+//! threads.
+//! @details Gives the same counts as perft() and perftDivide().
+class ParallelPerft
+{
+public:
+  //! @brief Constructor.
+  //! @param table The table of counts shared by the threads.
+  //! @param threads The number of threads, including the calling thread. At
+  //! least 1.
+  ParallelPerft(PerftTable &table, unsigned threads) noexcept;
+
+  //! @return The number of threads, including the calling thread.
+  //! @throw Never throws.
+  unsigned
+  threads() const noexcept;
+
+  //! @brief Count the leaf nodes of the tree of legal moves from a position.
+  //! @param board The board with the position.
+  //! @param depth The depth of the tree.
+  //! @return The number of leaf nodes. 1 if the depth is 0.
+  node_t
+  run(const Board &board, int depth);
+
+  //! @brief Count the leaf nodes below each legal move from a position.
+  //! @param board The board with the position.
+  //! @param depth The depth of the tree, which must be at least 1.
+  //! @return A vector with each legal move and the leaf nodes below it, in the
+  //! order in which the moves are generated.
+  std::vector<std::pair<PieceMove, node_t>>
+  divide(const Board &board, int depth);
+
+private:
+  PerftTable &mTable;
+  unsigned mThreads;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// the number of threads
+//
+inline unsigned
+ParallelPerft::threads() const noexcept
+{
+  return mThreads;
+}
+
+} // namespace zoor
+#endif // _PARALLELPERFT_H
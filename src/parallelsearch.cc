@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file parallelsearch.cc
+//! @author Omar A Serrano
+//! @date 2016-10-14
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+//
+// zoor
+//
+#include "board.hh"
+#include "parallelsearch.hh"
+#include "search.hh"
+#include "transtable.hh"
+
+namespace zoor {
+
+//
+// constructor
+//
+ParallelSearch::ParallelSearch(const StrategyFactory &factory,
+                               TransTable &table,
+                               unsigned threads)
+  : mTable(table)
+{
+  for (unsigned i = 0; i < std::max(threads, 1u); ++i) {
+    mStrategies.push_back(factory());
+    mSearches.emplace_back(new Search(*mStrategies.back(), table));
+  }
+}
+
+//
+// lazy SMP
+//
+SearchResult
+ParallelSearch::run(const Board &board, const SearchLimits &limits)
+{
+  const unsigned count = threads();
+  std::vector<Board> boards(count, board);
+  std::vector<node_t> helperNodes(count, 0);
+
+  for (auto &search : mSearches)
+    search->mStopRequest.store(false, std::memory_order_relaxed);
+  mTable.newSearch();
+
+  // the helpers search until the main thread is done
+  SearchLimits helperLimits;
+  helperLimits.depth = Search::MAX_PLY;
+
+  std::vector<std::thread> helpers;
+  try {
+    for (unsigned i = 1; i < count; ++i) {
+      helpers.emplace_back([this, i, &boards, &helperNodes, &helperLimits] {
+        helperNodes[i] = mSearches[i]->iterate(boards[i], helperLimits).nodes;
+      });
+    }
+  } catch (...) {
+    // a thread could not be started, so stop the ones that were
+    for (unsigned i = 1; i < count; ++i)
+      mSearches[i]->stop();
+    for (auto &helper : helpers)
+      helper.join();
+    throw;
+  }
+
+  SearchLimits mainLimits = limits;
+  if (limits.nodes)
+    mainLimits.nodes = (limits.nodes + count - 1) / count;
+  auto result = mSearches[0]->iterate(boards[0], mainLimits);
+
+  for (unsigned i = 1; i < count; ++i)
+    mSearches[i]->stop();
+  for (auto &helper : helpers)
+    helper.join();
+
+  for (auto nodes : helperNodes)
+    result.nodes += nodes;
+  return result;
+}
+
+} // namespace zoor
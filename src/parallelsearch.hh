@@ -0,0 +1,93 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file parallelsearch.hh
+//! @author Omar A Serrano
+//! @date 2016-10-14
+//! @details Lazy SMP: several threads run the same iterative deepening search
+//! from the root, each on its own copy of the board, and share only the
+//! transposition table. The threads do not coordinate, but what one thread
+//! stores in the table changes the move order and the cutoffs of the others,
+//! so together they search a wider tree than one thread would in the same
+//! time. The main thread enforces the limits, and tells the helper threads to
+//! stop when it is done.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _PARALLELSEARCH_H
+#define _PARALLELSEARCH_H
+
+//
+// STL
+//
+#include <functional>
+#include <memory>
+#include <vector>
+
+//
+// zoor
+//
+#include "istrategy.hh"
+#include "search.hh"
+
+namespace zoor {
+
+// Forward declarations.
+class Board;
+class TransTable;
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Searches for the best move with several threads.
+class ParallelSearch
+{
+public:
+  //! @brief Creates the strategy used by one thread.
+  //! @details Each thread gets its own strategy, since strategies may keep
+  //! state while scoring a position.
+  using StrategyFactory = std::function<std::unique_ptr<IStrategy>()>;
+
+  //! @brief Constructor.
+  //! @param factory Creates the strategy of each thread.
+  //! @param table The transposition table shared by the threads.
+  //! @param threads The number of threads, including the main thread. At
+  //! least 1.
+  ParallelSearch(const StrategyFactory &factory,
+                 TransTable &table,
+                 unsigned threads);
+
+  //! @return The number of threads, including the main thread.
+  //! @throw Never throws.
+  unsigned
+  threads() const noexcept;
+
+  //! @brief Search for the best move.
+  //! @details The node limit is shared evenly by the threads. The time and
+  //! depth limits apply to the main thread, which stops the helper threads
+  //! when it is done.
+  //! @param board The board with the position.
+  //! @param limits The limits of the search.
+  //! @return The result of the main thread, with the nodes searched by all
+  //! the threads.
+  SearchResult
+  run(const Board &board, const SearchLimits &limits);
+
+private:
+  TransTable &mTable;
+  std::vector<std::unique_ptr<IStrategy>> mStrategies;
+  std::vector<std::unique_ptr<Search>> mSearches;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// the number of threads
+//
+inline unsigned
+ParallelSearch::threads() const noexcept
+{
+  return mSearches.size();
+}
+
+} // namespace zoor
+#endif // _PARALLELSEARCH_H
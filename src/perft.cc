@@ -0,0 +1,149 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file perft.cc
+//! @author Omar A Serrano
+//! @date 2016-10-11
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <cassert>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "chesserror.hh"
+#include "movelist.hh"
+#include "moveundo.hh"
+#include "perft.hh"
+#include "perfttable.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+//
+// count the leaf nodes
+//
+node_t
+perft(Board &board, int depth) noexcept
+{
+  if (depth <= 0)
+    return 1;
+
+  // the moves need not be generated to count the last level
+  if (depth == 1)
+    return board.countLegalMoves();
+
+  MoveList moveList;
+  board.getLegalMoves(moveList);
+
+  node_t nodes = 0;
+  for (auto &pm : moveList) {
+    MoveUndo undo;
+    board.makeMove(pm, undo);
+    nodes += perft(board, depth - 1);
+    board.unmakeMove(undo);
+  }
+
+  return nodes;
+}
+
+//
+// count the leaf nodes, with a table of counts
+//
+node_t
+perft(Board &board, int depth, PerftTable &table) noexcept
+{
+  if (depth <= 1)
+    return perft(board, depth);
+
+  const auto key = static_cast<PerftTable::key_type>(board.hashCode());
+  node_t nodes = 0;
+  if (table.probe(key, depth, nodes))
+    return nodes;
+
+  MoveList moveList;
+  board.getLegalMoves(moveList);
+  for (auto &pm : moveList) {
+    MoveUndo undo;
+    board.makeMove(pm, undo);
+    nodes += perft(board, depth - 1, table);
+    board.unmakeMove(undo);
+  }
+
+  table.store(key, depth, nodes);
+  return nodes;
+}
+
+//
+// count the leaf nodes below each move
+//
+std::vector<std::pair<PieceMove, node_t>>
+perftDivide(Board &board, int depth)
+{
+  assert(depth > 0);
+  std::vector<std::pair<PieceMove, node_t>> divideList;
+
+  MoveList moveList;
+  board.getLegalMoves(moveList);
+
+  for (auto &pm : moveList) {
+    MoveUndo undo;
+    board.makeMove(pm, undo);
+    divideList.emplace_back(pm, perft(board, depth - 1));
+    board.unmakeMove(undo);
+  }
+
+  return divideList;
+}
+
+//
+// read positions and expected counts
+//
+std::vector<PerftRecord>
+readPerft(const std::string &fileName)
+{
+  std::ifstream inFile(fileName);
+  if (not inFile.is_open())
+    throw ChessError("Unable to open perft file");
+
+  std::vector<PerftRecord> recordList;
+  std::string line;
+  while (std::getline(inFile, line)) {
+    if (line.empty())
+      continue;
+
+    std::istringstream iss(line);
+    PerftRecord record;
+    std::getline(iss, record.fen, ';');
+
+    // each count looks like "D<depth> <count>"
+    std::string field;
+    while (std::getline(iss, field, ';')) {
+      std::istringstream fss(field);
+      char d;
+      size_t depth;
+      node_t count;
+      if (not (fss >> d >> depth >> count) or d != 'D'
+          or depth != record.counts.size() + 1)
+        throw ChessError("Perft record is not valid");
+      record.counts.push_back(count);
+    }
+
+    recordList.push_back(record);
+  }
+
+  if (inFile.bad())
+    throw ChessError("Error processing perft file");
+
+  return recordList;
+}
+
+} // namespace zoor
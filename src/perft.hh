@@ -0,0 +1,87 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file perft.hh
+//! @author Omar A Serrano
+//! @date 2016-10-11
+//! @details Perft counts the leaf nodes of the tree of legal moves from a
+//! position, up to a given depth. The counts for well known positions are
+//! published, which makes perft a test of move generation, and the time it
+//! takes a benchmark of @c Board.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _PERFT_H
+#define _PERFT_H
+
+//
+// STL
+//
+#include <string>
+#include <utility>
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "perfttable.hh"
+#include "piecemove.hh"
+
+namespace zoor {
+
+//! @brief A position with its expected perft counts.
+struct PerftRecord
+{
+  //! @brief The position in FEN notation.
+  std::string fen;
+
+  //! @brief The expected count at each depth, starting with depth 1.
+  std::vector<node_t> counts;
+};
+
+//! @brief Count the leaf nodes of the tree of legal moves from a position.
+//! @details Moves are made and taken back on the board, which is left in the
+//! same position when the function returns. The moves come from
+//! Board::getLegalMoves(), and the moves of the last level are counted with
+//! Board::countLegalMoves(), without being generated.
+//! @param board The board with the position.
+//! @param depth The depth of the tree.
+//! @return The number of leaf nodes. 1 if the depth is 0.
+//! @throw Never throws.
+node_t
+perft(Board &board, int depth) noexcept;
+
+//! @brief Count the leaf nodes of the tree of legal moves from a position,
+//! reusing the counts of positions reached before.
+//! @details Like perft(Board&, int), but looks up the count of every position
+//! at least two moves from the leaves in a table before counting it, and
+//! stores it after.
+//! @param board The board with the position.
+//! @param depth The depth of the tree.
+//! @param table The table of counts.
+//! @return The number of leaf nodes. 1 if the depth is 0.
+//! @throw Never throws.
+node_t
+perft(Board &board, int depth, PerftTable &table) noexcept;
+
+//! @brief Count the leaf nodes below each legal move from a position.
+//! @details Useful to find the move with a wrong count when a perft count
+//! does not match the expected count.
+//! @param board The board with the position.
+//! @param depth The depth of the tree, which must be at least 1.
+//! @return A vector with each legal move and the leaf nodes below it, in the
+//! order in which the moves are generated.
+std::vector<std::pair<PieceMove, node_t>>
+perftDivide(Board &board, int depth);
+
+//! @brief Read positions and their expected perft counts from a file.
+//! @details Each line of the file has a FEN record followed by the counts in
+//! the format used by EPD test suites, e.g.,
+//! <em>8/8/8/8/8/8/8/K6k w - - 0 1 ;D1 3 ;D2 9</em>. The depths must start at
+//! 1 and be consecutive. Empty lines are skipped.
+//! @param fileName The name of the file.
+//! @return A vector with a @c PerftRecord for each line.
+//! @throw ChessError if the file cannot be read or a line is not valid.
+std::vector<PerftRecord>
+readPerft(const std::string &fileName);
+
+} // namespace zoor
+#endif // _PERFT_H
@@ -0,0 +1,205 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file perftmain.cc
+//! @author Omar A Serrano
+//! @date 2016-10-11
+//! @details Command line driver for perft. Usage:
+//! @li <em>zoor_perft [-d] depth [fen]</em> counts the leaf nodes of a
+//! position, which is the initial position if no FEN record is given. With
+//! <em>-d</em>, also prints the count below each move.
+//! @li <em>zoor_perft -s file [depth]</em> checks the counts of every position
+//! in a perft file up to the given depth, which is 4 by default. Exits with a
+//! non-zero status if any count is wrong.
+//!
+//! Either form may start with <em>-t threads</em> to count with
+//! @c ParallelPerft, using the given number of threads and a table of counts
+//! of PERFT_TABLE_MB megabytes. With <em>-t 0</em>, there is one thread for
+//! each core.
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <chrono>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+
+//
+// zoor
+//
+#include "board.hh"
+#include "fenrecord.hh"
+#include "iofen.hh"
+#include "parallelperft.hh"
+#include "perft.hh"
+#include "perfttable.hh"
+#include "piecemove.hh"
+
+namespace {
+
+using namespace zoor;
+using clock_type = std::chrono::steady_clock;
+
+//
+// the size of the table of counts of a parallel perft
+//
+const size_t PERFT_TABLE_MB = 256;
+
+//
+// counts with the serial perft, or with a parallel perft if it is not null
+//
+std::unique_ptr<ParallelPerft> parallel;
+
+//
+// count the leaf nodes below a position
+//
+node_t
+count(Board &board, int depth)
+{
+  return parallel ? parallel->run(board, depth) : perft(board, depth);
+}
+
+//
+// print how to use the program
+//
+int
+usage()
+{
+  std::cerr << "usage: zoor_perft [-t threads] [-d] depth [fen]\n"
+            << "       zoor_perft [-t threads] -s file [depth]\n";
+  return 2;
+}
+
+//
+// seconds since a point in time
+//
+double
+elapsed(clock_type::time_point start)
+{
+  std::chrono::duration<double> secs = clock_type::now() - start;
+  return secs.count();
+}
+
+//
+// print the node count, time, and nodes per second
+//
+void
+report(node_t nodes, double secs)
+{
+  std::cout << "nodes: " << nodes << "\n"
+            << "time: " << secs << " s\n"
+            << "nps: " << static_cast<node_t>(secs > 0 ? nodes / secs : 0)
+            << std::endl;
+}
+
+//
+// count the nodes of one position
+//
+int
+runPosition(Board board, int depth, bool divide)
+{
+  auto start = clock_type::now();
+  node_t nodes = 0;
+
+  if (divide and depth > 0) {
+    auto divideList = parallel ? parallel->divide(board, depth)
+                               : perftDivide(board, depth);
+    for (auto &moveCount : divideList) {
+      std::cout << algebraic(moveCount.first) << ": "
+                << moveCount.second << "\n";
+      nodes += moveCount.second;
+    }
+    std::cout << "\n";
+  } else
+    nodes = count(board, depth);
+
+  report(nodes, elapsed(start));
+  return 0;
+}
+
+//
+// check the counts of all the positions in a file
+//
+int
+runSuite(const std::string &fileName, int maxDepth)
+{
+  auto start = clock_type::now();
+  node_t nodes = 0;
+  int failed = 0;
+
+  for (auto &record : readPerft(fileName)) {
+    auto board = *readFenLine(record.fen).boardPtr();
+    std::cout << record.fen << "\n";
+    for (size_t i = 0; i < record.counts.size(); ++i) {
+      int depth = i + 1;
+      if (depth > maxDepth)
+        break;
+      auto leaves = count(board, depth);
+      nodes += leaves;
+      bool ok = leaves == record.counts[i];
+      failed += ok ? 0 : 1;
+      std::cout << "  depth " << depth << ": " << leaves
+                << (ok ? "" : " FAILED, expected ")
+                << (ok ? "" : std::to_string(record.counts[i])) << "\n";
+    }
+  }
+
+  std::cout << "\n";
+  report(nodes, elapsed(start));
+  return failed == 0 ? 0 : 1;
+}
+
+} // namespace
+
+int
+main(int argc, char *argv[])
+{
+  try {
+    int i = 1;
+    std::unique_ptr<PerftTable> table;
+    if (i < argc and std::string(argv[i]) == "-t") {
+      if (i + 1 >= argc)
+        return usage();
+      int threads = std::atoi(argv[i + 1]);
+      if (threads <= 0)
+        threads = std::thread::hardware_concurrency();
+      table.reset(new PerftTable(PERFT_TABLE_MB));
+      parallel.reset(new ParallelPerft(*table, threads));
+      i += 2;
+    }
+
+    if (i < argc and std::string(argv[i]) == "-s") {
+      if (argc - i < 2 or argc - i > 3)
+        return usage();
+      int depth = argc - i == 3 ? std::atoi(argv[i + 2]) : 4;
+      return runSuite(argv[i + 1], depth);
+    }
+
+    bool divide = false;
+    if (i < argc and std::string(argv[i]) == "-d") {
+      divide = true;
+      ++i;
+    }
+
+    if (i >= argc)
+      return usage();
+    int depth = std::atoi(argv[i++]);
+
+    // the FEN record may be given as one argument or as several
+    std::string fen;
+    for (; i < argc; ++i)
+      fen += std::string(argv[i]) + " ";
+
+    Board board;
+    if (not fen.empty())
+      board = *readFenLine(fen).boardPtr();
+
+    return runPosition(board, depth, divide);
+  } catch (const std::exception &e) {
+    std::cerr << "zoor_perft: " << e.what() << std::endl;
+    return 1;
+  }
+}
@@ -0,0 +1,121 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file perfttable.cc
+//! @author Omar A Serrano
+//! @date 2016-10-25
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+//
+// zoor
+//
+#include "perfttable.hh"
+
+namespace zoor {
+
+//
+// init static vars
+//
+constexpr node_t PerftTable::MAX_NODES;
+
+//
+// empty slot
+//
+PerftTable::Slot::Slot() noexcept
+  : xkey(0),
+    data(0) {}
+
+//
+// constructor
+//
+PerftTable::PerftTable(size_t megabytes)
+  : mBuckets(),
+    mMask(0)
+{
+  resize(megabytes);
+}
+
+//
+// allocate the buckets
+//
+void
+PerftTable::resize(size_t megabytes)
+{
+  size_t count = (megabytes << 20) / sizeof(Bucket);
+  size_t buckets = 1;
+  while (buckets <= count / 2)
+    buckets <<= 1;
+
+  // release the old table first, so both are never allocated at once
+  mBuckets.reset();
+  mBuckets.reset(new Bucket[buckets]);
+  mMask = buckets - 1;
+}
+
+//
+// remove all the entries
+//
+void
+PerftTable::clear() noexcept
+{
+  for (size_t i = 0; i <= mMask; ++i) {
+    for (auto &slot : mBuckets[i].slots) {
+      slot.xkey.store(0, std::memory_order_relaxed);
+      slot.data.store(0, std::memory_order_relaxed);
+    }
+  }
+}
+
+//
+// find a count
+//
+bool
+PerftTable::probe(key_type key, int depth, node_t &nodes) const noexcept
+{
+  assert(depth > 0 and depth <= UINT8_MAX);
+  for (auto &slot : mBuckets[key & mMask].slots) {
+    auto data = slot.data.load(std::memory_order_relaxed);
+    auto xkey = slot.xkey.load(std::memory_order_relaxed);
+    // an empty slot has depth 0, which is never probed
+    if ((xkey ^ data) == key and static_cast<int>(data & 0xff) == depth) {
+      nodes = data >> 8;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//
+// store a count
+//
+void
+PerftTable::store(key_type key, int depth, node_t nodes) noexcept
+{
+  assert(depth > 0 and depth <= UINT8_MAX);
+  if (nodes > MAX_NODES)
+    return;
+
+  // replace the shallowest entry
+  auto &slots = mBuckets[key & mMask].slots;
+  auto victim = &slots[0];
+  auto victimDepth = slots[0].data.load(std::memory_order_relaxed) & 0xff;
+  for (size_t i = 1; i < BUCKET_SIZE; ++i) {
+    auto d = slots[i].data.load(std::memory_order_relaxed) & 0xff;
+    if (d < victimDepth) {
+      victim = &slots[i];
+      victimDepth = d;
+    }
+  }
+
+  uint64_t data = nodes << 8 | static_cast<uint64_t>(depth);
+  victim->data.store(data, std::memory_order_relaxed);
+  victim->xkey.store(key ^ data, std::memory_order_relaxed);
+}
+
+} // namespace zoor
@@ -0,0 +1,132 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file perfttable.hh
+//! @author Omar A Serrano
+//! @date 2016-10-25
+//! @details The perft table remembers the leaf count below a position at a
+//! given depth, so that a position reached again through a different sequence
+//! of moves is not counted twice. It is laid out like @c TransTable: one
+//! array of cache line sized buckets, allocated once, with a number of buckets
+//! that is a power of two. The data of an entry is packed in 64 bits, with the
+//! depth in the low 8 bits and the leaf count in the high 56 bits.
+//!
+//! The table may be shared by threads without locks. Each slot keeps the data
+//! and the hash XORed with the data in two atomic words, so an entry torn by
+//! two stores at once is ignored, as it is in @c TransTable.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _PERFTTABLE_H
+#define _PERFTTABLE_H
+
+//
+// STL
+//
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "zobrist.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief A table of perft counts with a fixed number of buckets.
+//! @details probe() and store() may be called by several threads at once. The
+//! other functions may not be called while a thread is probing or storing.
+class PerftTable
+{
+public:
+  //! @brief Alias for the type of the hash.
+  using key_type = Zobrist::key_type;
+
+  //! @brief The number of entries in a bucket.
+  enum { BUCKET_SIZE = 4 };
+
+  //! @brief The largest leaf count that fits in an entry.
+  static constexpr node_t MAX_NODES = (node_t(1) << 56) - 1;
+
+  //! @brief Constructor.
+  //! @details Uses as many buckets as fit in the given size, rounded down to a
+  //! power of two, but at least one.
+  //! @param megabytes The memory budget of the table, in MB.
+  //! @throw std::bad_alloc if the memory cannot be allocated.
+  explicit
+  PerftTable(size_t megabytes);
+
+  //! @brief Change the size of the table.
+  //! @details The entries are lost.
+  //! @param megabytes The memory budget of the table, in MB.
+  //! @throw std::bad_alloc if the memory cannot be allocated.
+  void
+  resize(size_t megabytes);
+
+  //! @brief Remove all the entries.
+  //! @throw Never throws.
+  void
+  clear() noexcept;
+
+  //! @brief Find the leaf count of a position at a depth.
+  //! @param key The hash of the position, e.g., @c Board::hashCode().
+  //! @param depth The depth, between 1 and 255.
+  //! @param nodes The leaf count, if found.
+  //! @return True if the count was found.
+  //! @throw Never throws.
+  bool
+  probe(key_type key, int depth, node_t &nodes) const noexcept;
+
+  //! @brief Store the leaf count of a position at a depth.
+  //! @details Replaces the entry of the bucket with the smallest depth, since
+  //! it is the cheapest to count again. A count above MAX_NODES is not stored.
+  //! @param key The hash of the position, e.g., @c Board::hashCode().
+  //! @param depth The depth, between 1 and 255.
+  //! @param nodes The leaf count.
+  //! @throw Never throws.
+  void
+  store(key_type key, int depth, node_t nodes) noexcept;
+
+  //! @return The number of entries in the table.
+  //! @throw Never throws.
+  size_t
+  size() const noexcept;
+
+private:
+  // an entry, stored as the hash XORed with the data, and the data
+  struct Slot
+  {
+    std::atomic<key_type> xkey;
+    std::atomic<uint64_t> data;
+
+    Slot() noexcept;
+  };
+
+  // a bucket fills a cache line
+  struct alignas(64) Bucket
+  {
+    Slot slots[BUCKET_SIZE];
+  };
+
+  std::unique_ptr<Bucket[]> mBuckets;
+  size_t mMask;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// the number of entries
+//
+inline size_t
+PerftTable::size() const noexcept
+{
+  return (mMask + 1) * BUCKET_SIZE;
+}
+
+} // namespace zoor
+#endif // _PERFTTABLE_H
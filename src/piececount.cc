@@ -8,12 +8,14 @@
 // STL
 //
 #include <cassert>
+#include <utility>
 #include <vector>
 
 //
 // zoor
 //
 #include "basictypes.hh"
+#include "bitboard.hh"
 #include "board.hh"
 #include "piececount.hh"
 #include "square.hh"
@@ -31,13 +33,10 @@ using std::vector;
 PieceCount&
 PieceCount::count(const Board &board) noexcept
 {
-  // clear the count
-  mWhite = 0;
-  mBlack = 0;
-
-  // count the pieces
-  for (auto &it : board)
-    add(it);
+  // the bitboards of each piece are counted, instead of visiting every square
+  auto &bits = board.base().bits();
+  mWhite = countBits(bits, Color::W);
+  mBlack = countBits(bits, Color::B);
 
   return *this;
 }
@@ -73,6 +72,29 @@ PieceCount::good() const noexcept
       and wPawn() <= PMAX and bPawn() <= PMAX;
 }
 
+//
+// the counts of the pieces of a color, from the bitboards
+//
+PieceCount::count_type
+PieceCount::countBits(const BitBoard &bits, Color color) noexcept
+{
+  static const std::pair<Piece, count_type> SHIFT[] = {
+    {Piece::P, PSHIFT}, {Piece::N, NSHIFT}, {Piece::B, BSHIFT},
+    {Piece::R, RSHIFT}, {Piece::Q, QSHIFT}, {Piece::K, KSHIFT}
+  };
+
+  count_type cnt = 0;
+  for (auto &pcShift : SHIFT) {
+    count_type value = popCount(bits.pieces(color, pcShift.first));
+    // don't count more than 5 bits can hold, as add() does
+    if (value > CMASK)
+      value = CMASK;
+    cnt |= value << pcShift.second;
+  }
+
+  return cnt;
+}
+
 //
 // add the piece code to the white or black count
 //
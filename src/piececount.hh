@@ -16,6 +16,7 @@
 // zoor
 //
 #include "basictypes.hh"
+#include "bitboard.hh"
 #include "board.hh"
 #include "square.hh"
 
@@ -200,6 +201,16 @@ private:
   void
   add(const piece_t code) noexcept;
 
+  //
+  // @brief Count the pieces of a color in a set of bitboards.
+  // @param bits The bitboards of a board.
+  // @param color The color of the pieces.
+  // @return The count of each piece of the color, packed like mWhite.
+  // @throw Never throws.
+  //
+  static count_type
+  countBits(const BitBoard &bits, Color color) noexcept;
+
   // Mantain the count of white and black pieces.
   count_type mWhite;
   count_type mBlack;
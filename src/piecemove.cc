@@ -132,4 +132,36 @@ operator<<(std::ostream &os, const PieceMove &pm)
   return os;
 }
 
+//
+// long algebraic notation
+//
+std::string
+algebraic(const PieceMove &pm)
+{
+  std::string str;
+  str += static_cast<char>('a' + pm.sColumn());
+  str += static_cast<char>('1' + pm.sRow());
+  str += static_cast<char>('a' + pm.dColumn());
+  str += static_cast<char>('1' + pm.dRow());
+
+  if (pm.isPromo()) {
+    switch (pm.dPiece()) {
+    case Piece::N:
+      str += 'n';
+      break;
+    case Piece::B:
+      str += 'b';
+      break;
+    case Piece::R:
+      str += 'r';
+      break;
+    default:
+      str += 'q';
+      break;
+    }
+  }
+
+  return str;
+}
+
 } // namespace zoor
@@ -492,6 +492,14 @@ operator!=(const PieceMove &pm1, const PieceMove &pm2) noexcept;
 std::ostream&
 operator<<(std::ostream &os, const PieceMove &pm);
 
+//! @brief The move in long algebraic notation, e.g., <em>e2e4</em>, or
+//! <em>e7e8q</em> for a promotion.
+//! @param pm The @c PieceMove.
+//! @return A string with the squares the piece moves from and to, followed by
+//! the promotion piece, if any.
+std::string
+algebraic(const PieceMove &pm);
+
 ////////////////////////////////////////////////////////////////////////////////
 // definitions
 ////////////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,157 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file psqt.cc
+//! @author Omar A Serrano
+//! @date 2016-10-22
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "psqt.hh"
+
+namespace zoor {
+
+//
+// init static vars
+//
+constexpr int Psqt::PHASE_MAX;
+int Psqt::sMidgame[2][6][64];
+int Psqt::sEndgame[2][6][64];
+
+namespace {
+
+//
+// The square bonuses of white, with the eighth row at the top and the first
+// row at the bottom, so that the tables read like a board from white's side.
+// Pawns, knights, bishops, rooks and queens use the same bonus in the
+// middlegame and the endgame. The pawns gain more from advancing in the
+// endgame, and the king goes from hiding behind its pawns to the center.
+//
+
+const int PAWN[64] = {
+    0,   0,   0,   0,   0,   0,   0,   0,
+   50,  50,  50,  50,  50,  50,  50,  50,
+   10,  10,  20,  30,  30,  20,  10,  10,
+    5,   5,  10,  25,  25,  10,   5,   5,
+    0,   0,   0,  20,  20,   0,   0,   0,
+    5,  -5, -10,   0,   0, -10,  -5,   5,
+    5,  10,  10, -20, -20,  10,  10,   5,
+    0,   0,   0,   0,   0,   0,   0,   0
+};
+
+const int PAWN_END[64] = {
+    0,   0,   0,   0,   0,   0,   0,   0,
+   80,  80,  80,  80,  80,  80,  80,  80,
+   50,  50,  50,  50,  50,  50,  50,  50,
+   30,  30,  30,  30,  30,  30,  30,  30,
+   15,  15,  15,  15,  15,  15,  15,  15,
+    5,   5,   5,   5,   5,   5,   5,   5,
+    0,   0,   0,   0,   0,   0,   0,   0,
+    0,   0,   0,   0,   0,   0,   0,   0
+};
+
+const int KNIGHT[64] = {
+  -50, -40, -30, -30, -30, -30, -40, -50,
+  -40, -20,   0,   0,   0,   0, -20, -40,
+  -30,   0,  10,  15,  15,  10,   0, -30,
+  -30,   5,  15,  20,  20,  15,   5, -30,
+  -30,   0,  15,  20,  20,  15,   0, -30,
+  -30,   5,  10,  15,  15,  10,   5, -30,
+  -40, -20,   0,   5,   5,   0, -20, -40,
+  -50, -40, -30, -30, -30, -30, -40, -50
+};
+
+const int BISHOP[64] = {
+  -20, -10, -10, -10, -10, -10, -10, -20,
+  -10,   0,   0,   0,   0,   0,   0, -10,
+  -10,   0,   5,  10,  10,   5,   0, -10,
+  -10,   5,   5,  10,  10,   5,   5, -10,
+  -10,   0,  10,  10,  10,  10,   0, -10,
+  -10,  10,  10,  10,  10,  10,  10, -10,
+  -10,   5,   0,   0,   0,   0,   5, -10,
+  -20, -10, -10, -10, -10, -10, -10, -20
+};
+
+const int ROOK[64] = {
+    0,   0,   0,   0,   0,   0,   0,   0,
+    5,  10,  10,  10,  10,  10,  10,   5,
+   -5,   0,   0,   0,   0,   0,   0,  -5,
+   -5,   0,   0,   0,   0,   0,   0,  -5,
+   -5,   0,   0,   0,   0,   0,   0,  -5,
+   -5,   0,   0,   0,   0,   0,   0,  -5,
+   -5,   0,   0,   0,   0,   0,   0,  -5,
+    0,   0,   0,   5,   5,   0,   0,   0
+};
+
+const int QUEEN[64] = {
+  -20, -10, -10,  -5,  -5, -10, -10, -20,
+  -10,   0,   0,   0,   0,   0,   0, -10,
+  -10,   0,   5,   5,   5,   5,   0, -10,
+   -5,   0,   5,   5,   5,   5,   0,  -5,
+    0,   0,   5,   5,   5,   5,   0,  -5,
+  -10,   5,   5,   5,   5,   5,   0, -10,
+  -10,   0,   5,   0,   0,   0,   0, -10,
+  -20, -10, -10,  -5,  -5, -10, -10, -20
+};
+
+const int KING[64] = {
+  -30, -40, -40, -50, -50, -40, -40, -30,
+  -30, -40, -40, -50, -50, -40, -40, -30,
+  -30, -40, -40, -50, -50, -40, -40, -30,
+  -30, -40, -40, -50, -50, -40, -40, -30,
+  -20, -30, -30, -40, -40, -30, -30, -20,
+  -10, -20, -20, -20, -20, -20, -20, -10,
+   20,  20,   0,   0,   0,   0,  20,  20,
+   20,  30,  10,   0,   0,  10,  30,  20
+};
+
+const int KING_END[64] = {
+  -50, -40, -30, -20, -20, -30, -40, -50,
+  -30, -20, -10,   0,   0, -10, -20, -30,
+  -30, -10,  20,  30,  30,  20, -10, -30,
+  -30, -10,  30,  40,  40,  30, -10, -30,
+  -30, -10,  30,  40,  40,  30, -10, -30,
+  -30, -10,  20,  30,  30,  20, -10, -30,
+  -30, -30,   0,   0,   0,   0, -30, -30,
+  -50, -30, -30, -30, -30, -30, -30, -50
+};
+
+// The bonuses, indexed by piece.
+const int *const MIDGAME[6] = {PAWN, KNIGHT, BISHOP, ROOK, QUEEN, KING};
+const int *const ENDGAME[6] = {PAWN_END, KNIGHT, BISHOP, ROOK, QUEEN, KING_END};
+
+// The endgame values of the pieces, indexed by piece. Pawns and rooks are worth
+// a bit more, and knights a bit less, with fewer pieces on the board.
+const int VALUE_END[6] = {120, 280, 300, 520, 900, 0};
+
+} // namespace
+
+//
+// Adds the value of each piece to its square bonus. A square of white is found
+// in the tables by flipping its row, and a square of black is found as is,
+// since the tables of black are the tables of white seen from black's side.
+//
+struct Psqt::Init
+{
+  Init() noexcept
+  {
+    Piece pcArr[] = {
+      Piece::P, Piece::N, Piece::B, Piece::R, Piece::Q, Piece::K
+    };
+    for (auto pc : pcArr) {
+      auto p = pieceIndex(pc);
+      for (dim_t index = 0; index < 64; ++index) {
+        auto white = index ^ 56;
+        sMidgame[0][p][index] = pieceValue(pc) + MIDGAME[p][white];
+        sEndgame[0][p][index] = VALUE_END[p] + ENDGAME[p][white];
+        sMidgame[1][p][index] = pieceValue(pc) + MIDGAME[p][index];
+        sEndgame[1][p][index] = VALUE_END[p] + ENDGAME[p][index];
+      }
+    }
+  }
+};
+
+const Psqt::Init Psqt::sInit;
+
+} // namespace zoor
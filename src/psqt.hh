@@ -0,0 +1,235 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file psqt.hh
+//! @author Omar A Serrano
+//! @date 2016-10-22
+//! @details Piece-square tables, which give every piece on every square a
+//! value for the middlegame and a value for the endgame, including the value of
+//! the piece itself. The score of a position is the sum of the values of its
+//! pieces, blended between the middlegame and the endgame by the game phase,
+//! which drops as the knights, bishops, rooks and queens leave the board. Since
+//! the score is a sum, it can be updated incrementally when a move is made by
+//! subtracting and adding only the values of the pieces that change squares.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _PSQT_H
+#define _PSQT_H
+
+//
+// STL
+//
+#include <cassert>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "bitboard.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Psqt contains the static piece-square tables.
+//! @details Copy control for Psqt has been removed, because it is not meant to
+//! be instantiated. The tables of black are the tables of white flipped from
+//! top to bottom, and are built before main() runs.
+struct Psqt
+{
+  // Remove copy control
+  Psqt() = delete;
+  Psqt(const Psqt&) = delete;
+  Psqt(Psqt&&) = delete;
+  Psqt& operator=(const Psqt&) = delete;
+  Psqt& operator=(Psqt&&) = delete;
+
+  //! @brief The phase of a position with all the knights, bishops, rooks and
+  //! queens on the board, or more after promotions.
+  static constexpr int PHASE_MAX = 24;
+
+  //! @param code The piece code, with a valid piece and color.
+  //! @param index The index of the square where the piece is located.
+  //! @return The middlegame value of the piece on the square, in centipawns.
+  //! @throw Never throws.
+  static int
+  midgame(piece_t code, dim_t index) noexcept;
+
+  //! @param code The piece code, with a valid piece and color.
+  //! @param index The index of the square where the piece is located.
+  //! @return The endgame value of the piece on the square, in centipawns.
+  //! @throw Never throws.
+  static int
+  endgame(piece_t code, dim_t index) noexcept;
+
+  //! @param code The piece code, with a valid piece and color.
+  //! @return The amount that the piece adds to the game phase: 1 for a knight
+  //! or a bishop, 2 for a rook, 4 for a queen, and 0 for a pawn or a king.
+  //! @throw Never throws.
+  static int
+  phase(piece_t code) noexcept;
+
+private:
+  // Builds the tables.
+  struct Init;
+
+  // Builds the tables before main() runs.
+  static const Init sInit;
+
+  // Middlegame values, indexed by color, piece, and square.
+  static int sMidgame[2][6][64];
+
+  // Endgame values, indexed by color, piece, and square.
+  static int sEndgame[2][6][64];
+};
+
+//! @brief The sums of the piece-square values of a position, for each color.
+//! @details Kept by @c Board, which adds and removes the value of a piece every
+//! time a square changes, so that a position is scored in constant time.
+struct PsqtScore
+{
+  //! @brief The middlegame sum, indexed with colorIndex().
+  int midgame[2];
+
+  //! @brief The endgame sum, indexed with colorIndex().
+  int endgame[2];
+
+  //! @brief The game phase, the sum of Psqt::phase() over all the pieces.
+  int phase;
+
+  //! @brief Add the values of a piece on a square.
+  //! @param code The piece code, with a valid piece and color.
+  //! @param index The index of the square.
+  //! @throw Never throws.
+  void
+  add(piece_t code, dim_t index) noexcept;
+
+  //! @brief Remove the values of a piece on a square.
+  //! @param code The piece code, with a valid piece and color.
+  //! @param index The index of the square.
+  //! @throw Never throws.
+  void
+  remove(piece_t code, dim_t index) noexcept;
+
+  //! @brief The score of a color, blended between the middlegame and the
+  //! endgame by the game phase.
+  //! @param color The color, which must not be Color::NONE.
+  //! @return The sums of the color minus the sums of the other color.
+  //! @throw Never throws.
+  int
+  value(Color color) const noexcept;
+};
+
+//! @brief Compares two @c PsqtScore objects for equality.
+//! @param score1 The first @c PsqtScore.
+//! @param score2 The second @c PsqtScore.
+//! @return True if all the sums are equal, false otherwise.
+//! @throw Never throws.
+bool
+operator==(const PsqtScore &score1, const PsqtScore &score2) noexcept;
+
+//! @brief Compares two @c PsqtScore objects for non-equality.
+//! @param score1 The first @c PsqtScore.
+//! @param score2 The second @c PsqtScore.
+//! @return False if all the sums are equal, true otherwise.
+//! @throw Never throws.
+bool
+operator!=(const PsqtScore &score1, const PsqtScore &score2) noexcept;
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// middlegame value of a piece on a square
+//
+inline int
+Psqt::midgame(piece_t code, dim_t index) noexcept
+{
+  assert(index >= 0 and index < 64);
+  return sMidgame[colorIndex(getColor(code))][pieceIndex(getPiece(code))][index];
+}
+
+//
+// endgame value of a piece on a square
+//
+inline int
+Psqt::endgame(piece_t code, dim_t index) noexcept
+{
+  assert(index >= 0 and index < 64);
+  return sEndgame[colorIndex(getColor(code))][pieceIndex(getPiece(code))][index];
+}
+
+//
+// game phase of a piece
+//
+inline int
+Psqt::phase(piece_t code) noexcept
+{
+  static const int PHASE[] = {0, 0, 1, 1, 2, 4, 0};
+  return PHASE[static_cast<piece_t>(getPiece(code))];
+}
+
+//
+// add a piece on a square
+//
+inline void
+PsqtScore::add(piece_t code, dim_t index) noexcept
+{
+  auto i = colorIndex(getColor(code));
+  midgame[i] += Psqt::midgame(code, index);
+  endgame[i] += Psqt::endgame(code, index);
+  phase += Psqt::phase(code);
+}
+
+//
+// remove a piece from a square
+//
+inline void
+PsqtScore::remove(piece_t code, dim_t index) noexcept
+{
+  auto i = colorIndex(getColor(code));
+  midgame[i] -= Psqt::midgame(code, index);
+  endgame[i] -= Psqt::endgame(code, index);
+  phase -= Psqt::phase(code);
+}
+
+//
+// tapered score of a color
+//
+inline int
+PsqtScore::value(Color color) const noexcept
+{
+  auto us = colorIndex(color);
+  auto them = 1 - us;
+  auto mg = midgame[us] - midgame[them];
+  auto eg = endgame[us] - endgame[them];
+
+  // promotions may take the phase above the maximum
+  auto ph = phase < Psqt::PHASE_MAX ? phase : Psqt::PHASE_MAX;
+  return (mg * ph + eg * (Psqt::PHASE_MAX - ph)) / Psqt::PHASE_MAX;
+}
+
+//
+// compare for equality
+//
+inline bool
+operator==(const PsqtScore &score1, const PsqtScore &score2) noexcept
+{
+  return score1.midgame[0] == score2.midgame[0]
+      && score1.midgame[1] == score2.midgame[1]
+      && score1.endgame[0] == score2.endgame[0]
+      && score1.endgame[1] == score2.endgame[1]
+      && score1.phase == score2.phase;
+}
+
+//
+// compare for non-equality
+//
+inline bool
+operator!=(const PsqtScore &score1, const PsqtScore &score2) noexcept
+{
+  return !(score1 == score2);
+}
+
+} // namespace zoor
+#endif // _PSQT_H
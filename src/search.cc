@@ -5,9 +5,365 @@
 ////////////////////////////////////////////////////////////////////////////////
 
 //
-// zoor headers
+// STL
 //
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <chrono>
+
+//
+// zoor
+//
+#include "board.hh"
+#include "istrategy.hh"
+#include "moveorder.hh"
+#include "movepicker.hh"
+#include "moveundo.hh"
+#include "packedmove.hh"
 #include "search.hh"
+#include "transtable.hh"
 
 namespace zoor {
+
+static_assert(int(MoveOrder::MAX_PLY) >= int(Search::MAX_PLY),
+              "Every ply of a search must have killer moves");
+
+namespace {
+
+//
+// how many nodes to search between checks of the clock
+//
+const node_t CLOCK_NODES = 1024;
+
+//
+// how many quiet moves of a node lose history after a cutoff
+//
+const int MAX_QUIETS = 64;
+
+//
+// how much a capture may gain over the material it wins
+//
+const int DELTA_MARGIN = 200;
+
+//
+// the most that a capture or promotion can raise the score
+//
+int
+materialGain(const PieceMove &pMove) noexcept
+{
+  int gain = pieceValue(pMove.xPiece());
+  if (pMove.isPromo())
+    gain += pieceValue(pMove.dPiece()) - pieceValue(Piece::P);
+  return gain;
+}
+
+//
+// mate scores are stored relative to the position, not to the root
+//
+int
+toTable(int score, int ply) noexcept
+{
+  if (score >= Search::MATE_SCORE - Search::MAX_PLY)
+    return score + ply;
+  if (score <= -Search::MATE_SCORE + Search::MAX_PLY)
+    return score - ply;
+  return score;
+}
+
+//
+// mate scores are read relative to the root
+//
+int
+fromTable(int score, int ply) noexcept
+{
+  if (score >= Search::MATE_SCORE - Search::MAX_PLY)
+    return score - ply;
+  if (score <= -Search::MATE_SCORE + Search::MAX_PLY)
+    return score + ply;
+  return score;
+}
+
+} // namespace
+
+const int Search::INFINITE_SCORE;
+const int Search::MATE_SCORE;
+
+//
+// constructor
+//
+Search::Search(IStrategy &strategy) noexcept
+  : mStrategy(strategy),
+    mTable(nullptr),
+    mLimits(),
+    mStart(),
+    mNodes(0),
+    mCanStop(false),
+    mStop(false),
+    mStopRequest(false)
+{
+  std::fill(mPvLength, mPvLength + MAX_PLY, 0);
+}
+
+//
+// constructor with a transposition table
+//
+Search::Search(IStrategy &strategy, TransTable &table) noexcept
+  : Search(strategy)
+{
+  mTable = &table;
+}
+
+//
+// start a new search
+//
+SearchResult
+Search::run(Board &board, const SearchLimits &limits)
+{
+  mStopRequest.store(false, std::memory_order_relaxed);
+  if (mTable)
+    mTable->newSearch();
+  return iterate(board, limits);
+}
+
+//
+// ask the search to stop
+//
+void
+Search::stop() noexcept
+{
+  mStopRequest.store(true, std::memory_order_relaxed);
+}
+
+//
+// iterative deepening
+//
+SearchResult
+Search::iterate(Board &board, const SearchLimits &limits)
+{
+  mLimits = limits;
+  mStart = clock_type::now();
+  mNodes = 0;
+  mCanStop = false;
+  mStop = false;
+  mOrder.clear();
+
+  SearchResult result;
+  const int maxDepth = std::min<int>(std::max(limits.depth, 1), MAX_PLY - 1);
+
+  for (int depth = 1; depth <= maxDepth; ++depth) {
+    int score = alphaBeta(board, depth, 0, -INFINITE_SCORE, INFINITE_SCORE);
+    if (mStop)
+      break;
+
+    result.score = score;
+    result.depth = depth;
+    result.pv.assign(mPv[0], mPv[0] + mPvLength[0]);
+    mCanStop = true;
+
+    // no point in searching deeper after finding a mate
+    if (isMate(score) or isOutOfBudget(true))
+      break;
+  }
+
+  std::chrono::duration<double> secs = clock_type::now() - mStart;
+  result.nodes = mNodes;
+  result.seconds = secs.count();
+  return result;
+}
+
+//
+// negamax with alpha-beta pruning
+//
+int
+Search::alphaBeta(Board &board, int depth, int ply, int alpha, int beta)
+  noexcept
+{
+  if (depth <= 0)
+    return quiescence(board, ply, alpha, beta);
+
+  assert(ply < MAX_PLY);
+  mPvLength[ply] = ply;
+
+  if (mStop or (mCanStop and isOutOfBudget(mNodes % CLOCK_NODES == 0))) {
+    mStop = true;
+    return 0;
+  }
+
+  ++mNodes;
+  if (ply == MAX_PLY - 1)
+    return mStrategy.score(board);
+
+  const auto key = static_cast<TransTable::key_type>(board.hashCode());
+  const int alphaIn = alpha;
+  PackedMove tableMove;
+  TransEntry entry;
+  if (mTable and mTable->probe(key, entry)) {
+    tableMove = entry.move();
+    if (ply > 0 and entry.depth() >= depth) {
+      int score = fromTable(entry.score(), ply);
+      if (entry.bound() != Bound::UPPER and score >= beta)
+        return beta;
+      if (entry.bound() != Bound::LOWER and score <= alpha)
+        return alpha;
+    }
+  }
+
+  // the move from the table is searched first
+  MovePicker picker(board, tableMove, mOrder, ply);
+  PieceMove pm;
+  int moveCount = 0;
+  PackedMove bestMove;
+
+  // the quiet moves searched before a cutoff lose history
+  PieceMove quiets[MAX_QUIETS];
+  int quietCount = 0;
+
+  while (picker.next(pm)) {
+    ++moveCount;
+    MoveUndo undo;
+    board.makeMove(pm, undo);
+    int score = -alphaBeta(board, depth - 1, ply + 1, -beta, -alpha);
+    board.unmakeMove(undo);
+
+    if (mStop)
+      return 0;
+
+    if (score > alpha) {
+      alpha = score;
+      bestMove = PackedMove(pm);
+      // the move followed by the principal variation of the child
+      mPv[ply][ply] = pm;
+      std::copy(mPv[ply + 1] + ply + 1, mPv[ply + 1] + mPvLength[ply + 1],
+                mPv[ply] + ply + 1);
+      mPvLength[ply] = mPvLength[ply + 1];
+      if (alpha >= beta) {
+        if (not pm.isCapture() and not pm.isPromo())
+          updateOrder(board, pm, quiets, quietCount, depth, ply);
+        break;
+      }
+    }
+
+    if (not pm.isCapture() and not pm.isPromo() and quietCount < MAX_QUIETS)
+      quiets[quietCount++] = pm;
+  }
+
+  auto bound = alpha >= beta ? Bound::LOWER
+             : alpha > alphaIn ? Bound::EXACT : Bound::UPPER;
+
+  // checkmate or stalemate
+  if (moveCount == 0) {
+    alpha = board.inCheck() ? -MATE_SCORE + ply : 0;
+    bound = Bound::EXACT;
+  }
+
+  if (mTable)
+    mTable->store(key, depth, bound, toTable(alpha, ply), bestMove);
+
+  return alpha;
+}
+
+//
+// search the captures until the position is quiet
+//
+int
+Search::quiescence(Board &board, int ply, int alpha, int beta) noexcept
+{
+  assert(ply < MAX_PLY);
+  mPvLength[ply] = ply;
+
+  if (mStop or (mCanStop and isOutOfBudget(mNodes % CLOCK_NODES == 0))) {
+    mStop = true;
+    return 0;
+  }
+
+  ++mNodes;
+  if (ply == MAX_PLY - 1)
+    return mStrategy.score(board);
+
+  // the player to move may stand pat, unless in check
+  const bool inCheck = board.inCheck();
+  int standPat = -INFINITE_SCORE;
+  if (not inCheck) {
+    standPat = mStrategy.score(board);
+    if (standPat >= beta)
+      return beta;
+    if (standPat > alpha)
+      alpha = standPat;
+  }
+
+  // the captures, or every evasion of a check
+  MovePicker picker(board);
+  PieceMove pm;
+  int moveCount = 0;
+
+  while (picker.next(pm)) {
+    ++moveCount;
+
+    // delta pruning, and the captures that lose material
+    if (not inCheck
+        and (standPat + materialGain(pm) + DELTA_MARGIN <= alpha
+             or not board.seeGE(pm, 0)))
+      continue;
+
+    MoveUndo undo;
+    board.makeMove(pm, undo);
+    int score = -quiescence(board, ply + 1, -beta, -alpha);
+    board.unmakeMove(undo);
+
+    if (mStop)
+      return 0;
+
+    if (score > alpha) {
+      alpha = score;
+      if (alpha >= beta)
+        break;
+    }
+  }
+
+  // checkmate
+  if (inCheck and moveCount == 0)
+    return -MATE_SCORE + ply;
+
+  return alpha;
+}
+
+//
+// learn from a quiet move that caused a cutoff
+//
+void
+Search::updateOrder(const Board &board,
+                    const PieceMove &pMove,
+                    const PieceMove *quiets,
+                    int quietCount,
+                    int depth,
+                    int ply) noexcept
+{
+  mOrder.addKiller(ply, pMove);
+  mOrder.setCounterMove(board.lastMove(), pMove);
+
+  int bonus = std::min(depth * depth, MoveOrder::HISTORY_MAX);
+  mOrder.addHistory(pMove, bonus);
+  for (int i = 0; i < quietCount; ++i)
+    mOrder.addHistory(quiets[i], -bonus);
+}
+
+//
+// check the node and time limits
+//
+bool
+Search::isOutOfBudget(bool checkClock) noexcept
+{
+  if (mStopRequest.load(std::memory_order_relaxed))
+    return true;
+
+  if (mLimits.nodes and mNodes >= mLimits.nodes)
+    return true;
+
+  if (checkClock and mLimits.time.count())
+    return clock_type::now() - mStart >= mLimits.time;
+
+  return false;
+}
+
 } // namespace zoor
@@ -2,12 +2,255 @@
 //! @file search.hh
 //! @author Omar A Serrano
 //! @date 2015-12-25
+//! @details Negamax alpha-beta search with iterative deepening. Each node of
+//! the tree is a position on a @c Board, which is changed in place with
+//! makeMove() and unmakeMove(). The leaves are extended with a quiescence
+//! search of the captures and promotions, and the quiet positions it reaches
+//! are scored with an @c IStrategy.
 ////////////////////////////////////////////////////////////////////////////////
 #ifndef _SEARCH_H
 #define _SEARCH_H
 
+//
+// STL
+//
+#include <atomic>
+#include <chrono>
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "moveorder.hh"
+#include "piecemove.hh"
+
 namespace zoor {
-// TODO: Create search class that implements alpha-beta pruning. Each node will
-// represent a chess board position.
+
+// Forward declarations.
+class Board;
+struct IStrategy;
+class TransTable;
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief The limits of a search.
+//! @details The search stops when it completes the last depth, or when it
+//! runs out of nodes or time. A limit of 0 for nodes or time means no limit.
+//! The search always completes depth 1, so that it has a move to return.
+struct SearchLimits
+{
+  //! @brief The deepest iteration, in plies.
+  int depth = 1;
+
+  //! @brief The largest number of nodes to search.
+  node_t nodes = 0;
+
+  //! @brief The longest time to search.
+  std::chrono::milliseconds time{0};
+};
+
+//! @brief The result of a search.
+struct SearchResult
+{
+  //! @brief The score of the position for the player making a move.
+  int score = 0;
+
+  //! @brief The depth of the last completed iteration.
+  int depth = 0;
+
+  //! @brief The principal variation, starting with the best move.
+  //! @details Empty if there are no legal moves.
+  std::vector<PieceMove> pv;
+
+  //! @brief The number of nodes searched, over all iterations.
+  node_t nodes = 0;
+
+  //! @brief The time the search took, in seconds.
+  double seconds = 0;
+
+  //! @brief The number of nodes searched per second.
+  //! @return The nodes per second, or 0 if no time was measured.
+  //! @throw Never throws.
+  node_t
+  nps() const noexcept;
+};
+
+//! @brief Searches for the best move with negamax alpha-beta.
+//! @details Runs one alpha-beta search for each depth up to the limit, and
+//! keeps the result of the last one that completes. Scores are from the
+//! perspective of the player making a move, like the scores of the strategy.
+//! With a transposition table, the best move stored for a position is searched
+//! first, and a stored bound that falls outside the window ends the search of
+//! the position. An exact score inside the window does not, so that the
+//! principal variation is not cut short. Moves are searched in the order of a
+//! @c MovePicker, with the killer moves, history and countermoves that the
+//! search learns from the quiet moves that cause cutoffs.
+//!
+//! Past the last depth, the quiescence search lets the player to move stand
+//! pat with the score of the strategy, or try a capture or promotion to do
+//! better, so that a leaf is not scored in the middle of an exchange. A
+//! capture that could not raise alpha even if it won the captured piece for
+//! free, plus a margin, is pruned, and so is a capture that loses material by
+//! static exchange evaluation. This delta pruning assumes that the strategy
+//! scores material in centipawns, with a pawn worth about 100.
+class Search
+{
+public:
+  //! @brief The largest number of plies from the root.
+  enum { MAX_PLY = 64 };
+
+  //! @brief A score larger than any other score.
+  static const int INFINITE_SCORE = 32000;
+
+  //! @brief The score of a checkmate at the root.
+  //! @details A checkmate @e n plies from the root scores MATE_SCORE - n, so
+  //! that shorter mates score higher. Strategies must score positions within
+  //! (-MATE_SCORE + MAX_PLY, MATE_SCORE - MAX_PLY).
+  static const int MATE_SCORE = 31000;
+
+  //! @brief Constructor.
+  //! @param strategy The strategy to score positions.
+  //! @throw Never throws.
+  explicit
+  Search(IStrategy &strategy) noexcept;
+
+  //! @brief Constructor for a search with a transposition table.
+  //! @details The table may be shared with other searches, one at a time, and
+  //! keeps its entries from one search to the next.
+  //! @param strategy The strategy to score positions.
+  //! @param table The transposition table.
+  //! @throw Never throws.
+  Search(IStrategy &strategy, TransTable &table) noexcept;
+
+  //! @brief Search for the best move.
+  //! @details The board is left in the same position when the function
+  //! returns.
+  //! @param board The board with the position.
+  //! @param limits The limits of the search.
+  //! @return The result of the last completed iteration.
+  SearchResult
+  run(Board &board, const SearchLimits &limits);
+
+  //! @brief Ask the search to stop.
+  //! @details May be called from another thread while run() searches. The
+  //! search still completes depth 1.
+  //! @throw Never throws.
+  void
+  stop() noexcept;
+
+  //! @brief Check if a score is a checkmate score.
+  //! @param score The score.
+  //! @return True if the score is a win or a loss by checkmate.
+  //! @throw Never throws.
+  static bool
+  isMate(int score) noexcept;
+
+private:
+  friend class ParallelSearch;
+
+  using clock_type = std::chrono::steady_clock;
+
+  //! @brief Run the iterations of the search.
+  //! @details Like run(), but does not start a new generation in the
+  //! transposition table nor clear a request to stop.
+  //! @param board The board with the position.
+  //! @param limits The limits of the search.
+  //! @return The result of the last completed iteration.
+  SearchResult
+  iterate(Board &board, const SearchLimits &limits);
+
+  //! @brief Search a node.
+  //! @param board The board with the position of the node.
+  //! @param depth The depth left to search.
+  //! @param ply The number of plies from the root.
+  //! @param alpha The lower bound of the score.
+  //! @param beta The upper bound of the score.
+  //! @return The score, bounded by alpha and beta. The score is meaningless
+  //! if the search was stopped.
+  //! @throw Never throws.
+  int
+  alphaBeta(Board &board, int depth, int ply, int alpha, int beta) noexcept;
+
+  //! @brief Search the captures and promotions of a node past the last depth.
+  //! @details In check, every move is searched, because standing pat is not
+  //! an option.
+  //! @param board The board with the position of the node.
+  //! @param ply The number of plies from the root.
+  //! @param alpha The lower bound of the score.
+  //! @param beta The upper bound of the score.
+  //! @return The score, bounded by alpha and beta. The score is meaningless
+  //! if the search was stopped.
+  //! @throw Never throws.
+  int
+  quiescence(Board &board, int ply, int alpha, int beta) noexcept;
+
+  //! @brief Check if the search ran out of nodes or time, or was asked to
+  //! stop.
+  //! @param checkClock True to also check the time, which is slower than
+  //! checking the nodes.
+  //! @return True if the search must stop.
+  //! @throw Never throws.
+  bool
+  isOutOfBudget(bool checkClock) noexcept;
+
+  //! @brief Update the move ordering tables after a quiet move caused a
+  //! cutoff.
+  //! @param board The board with the position of the cutoff.
+  //! @param pMove The move that caused the cutoff.
+  //! @param quiets The quiet moves searched before it.
+  //! @param quietCount The number of quiet moves searched before it.
+  //! @param depth The depth of the search of the position.
+  //! @param ply The ply of the position.
+  //! @throw Never throws.
+  void
+  updateOrder(const Board &board,
+              const PieceMove &pMove,
+              const PieceMove *quiets,
+              int quietCount,
+              int depth,
+              int ply) noexcept;
+
+  IStrategy &mStrategy;
+  TransTable *mTable;
+  SearchLimits mLimits;
+  clock_type::time_point mStart;
+  node_t mNodes;
+  bool mCanStop;
+  bool mStop;
+  std::atomic<bool> mStopRequest;
+
+  // triangular table with the principal variation below each ply
+  PieceMove mPv[MAX_PLY][MAX_PLY];
+  int mPvLength[MAX_PLY];
+
+  // killer moves, history and countermoves, kept for one search
+  MoveOrder mOrder;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// nodes per second
+//
+inline node_t
+SearchResult::nps() const noexcept
+{
+  return seconds > 0 ? static_cast<node_t>(nodes / seconds) : 0;
 }
+
+//
+// is it a mate score
+//
+inline bool
+Search::isMate(int score) noexcept
+{
+  return score >= MATE_SCORE - MAX_PLY or score <= -MATE_SCORE + MAX_PLY;
+}
+
+} // namespace zoor
 #endif // _SEARCH_H
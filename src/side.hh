@@ -0,0 +1,78 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file side.hh
+//! @author Omar A Serrano
+//! @date 2016-10-23
+//! @details The rows and the direction of the pieces of each color, as
+//! compile time constants. Code that is templated on the color of the player to
+//! move uses them instead of testing the color, so that the move generators
+//! are compiled once for white and once for black, without a branch on the
+//! color in their loops.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _SIDE_H
+#define _SIDE_H
+
+//
+// zoor
+//
+#include "basictypes.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief The constants of the pieces of a color.
+//! @details Only defined for Color::W and Color::B.
+//! @tparam C The color.
+template<Color C>
+struct Side;
+
+//! @brief The constants of the white pieces.
+template<>
+struct Side<Color::W>
+{
+  //! @brief The other color.
+  static constexpr Color THEM = Color::B;
+
+  //! @brief The change of row of a pawn moving forward.
+  static constexpr dim_t FORWARD = 1;
+
+  //! @brief The row of the king and rooks before castling.
+  static constexpr dim_t FIRST_ROW = 0;
+
+  //! @brief The row from which a pawn can move two squares.
+  static constexpr dim_t PAWN_ROW = 1;
+
+  //! @brief The row from which a pawn can capture en passant.
+  static constexpr dim_t EN_PASSANT_ROW = 4;
+
+  //! @brief The row from which a pawn promotes.
+  static constexpr dim_t PROMO_ROW = 6;
+};
+
+//! @brief The constants of the black pieces.
+template<>
+struct Side<Color::B>
+{
+  //! @brief The other color.
+  static constexpr Color THEM = Color::W;
+
+  //! @brief The change of row of a pawn moving forward.
+  static constexpr dim_t FORWARD = -1;
+
+  //! @brief The row of the king and rooks before castling.
+  static constexpr dim_t FIRST_ROW = 7;
+
+  //! @brief The row from which a pawn can move two squares.
+  static constexpr dim_t PAWN_ROW = 6;
+
+  //! @brief The row from which a pawn can capture en passant.
+  static constexpr dim_t EN_PASSANT_ROW = 3;
+
+  //! @brief The row from which a pawn promotes.
+  static constexpr dim_t PROMO_ROW = 1;
+};
+
+} // namespace zoor
+#endif // _SIDE_H
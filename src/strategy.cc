@@ -15,7 +15,6 @@ namespace zoor {
 int
 Strategy::score(const Board& board) noexcept
 {
-  mPieceCount.count(board);
   // TODO: things to consider:
   // are knights developed? what is mobility?
   // are bishops developed? what is mobility?
@@ -25,7 +24,7 @@ Strategy::score(const Board& board) noexcept
   // is king attacked? is king protected? is king's vicinity attacked?
   // how many pieces are attacked?
   // who controls the board?
-  return 0;
+  return board.psqtScore();
 }
 
 } // namespace zoor
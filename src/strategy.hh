@@ -7,18 +7,17 @@
 #define _STRATEGY_H
 
 #include "istrategy.hh"
-#include "piececount.hh"
 
 namespace zoor {
 
 class Board;
 
-//! The default strategy for evaluating a chess position.
+//! @brief The default strategy for evaluating a chess position.
+//! @details Starts from the piece-square sums that the board keeps up to date,
+//! so that the board is not scanned at every leaf of a search.
 class Strategy
   : public IStrategy
 {
-  PieceCount mPieceCount;
-
 public:
   //! @copydoc IStrategy::score()
   int
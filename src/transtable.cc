@@ -0,0 +1,195 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file transtable.cc
+//! @author Omar A Serrano
+//! @date 2016-10-13
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <algorithm>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+
+//
+// zoor
+//
+#include "packedmove.hh"
+#include "transtable.hh"
+
+namespace zoor {
+
+namespace {
+
+//
+// the number of buckets sampled to estimate the fill rate
+//
+const size_t SAMPLE_BUCKETS = 250;
+
+} // namespace
+
+//
+// default ctor
+//
+TransEntry::TransEntry() noexcept
+  : mKey(0),
+    mData(0) {}
+
+//
+// pack the fields of an entry
+//
+TransEntry::TransEntry(key_type key,
+                       int depth,
+                       Bound bound,
+                       int score,
+                       PackedMove move,
+                       unsigned generation) noexcept
+  : mKey(key)
+{
+  assert(depth >= 0 and depth <= UINT8_MAX);
+  assert(score >= INT16_MIN and score <= INT16_MAX);
+  assert(generation < 64);
+
+  mData = static_cast<data_type>(move.data())
+        | static_cast<data_type>(bound) << BOUND_SHIFT
+        | static_cast<data_type>(generation) << GENERATION_SHIFT
+        | static_cast<data_type>(static_cast<uint8_t>(depth)) << DEPTH_SHIFT
+        | static_cast<data_type>(static_cast<uint16_t>(score)) << SCORE_SHIFT;
+}
+
+//
+// constructor
+//
+TransTable::TransTable(size_t megabytes, Replace policy)
+  : mBuckets(),
+    mMask(0),
+    mPolicy(policy),
+    mGeneration(0)
+{
+  resize(megabytes);
+}
+
+//
+// allocate the buckets
+//
+void
+TransTable::resize(size_t megabytes)
+{
+  size_t count = (megabytes << 20) / sizeof(Bucket);
+  size_t buckets = 1;
+  while (buckets <= count / 2)
+    buckets <<= 1;
+
+  // release the old table first, so both are never allocated at once
+  mBuckets.reset();
+  mBuckets.reset(new Bucket[buckets]);
+  mMask = buckets - 1;
+  mGeneration = 0;
+}
+
+//
+// remove all the entries
+//
+void
+TransTable::clear() noexcept
+{
+  for (size_t i = 0; i <= mMask; ++i) {
+    for (auto &slot : mBuckets[i].slots)
+      slot.save(TransEntry());
+  }
+  mGeneration = 0;
+}
+
+//
+// start a new generation
+//
+void
+TransTable::newSearch() noexcept
+{
+  mGeneration = (mGeneration + 1) % GENERATIONS;
+}
+
+//
+// find an entry
+//
+bool
+TransTable::probe(key_type key, TransEntry &entry) const noexcept
+{
+  for (auto &slot : bucket(key).slots) {
+    auto e = slot.load();
+    if (e.mKey == key and not e.empty()) {
+      entry = e;
+      return true;
+    }
+  }
+
+  return false;
+}
+
+//
+// store an entry
+//
+void
+TransTable::store(key_type key, int depth, Bound bound, int score,
+                  PackedMove move) noexcept
+{
+  assert(bound != Bound::NONE);
+  auto &slots = bucket(key).slots;
+  TransEntry entries[BUCKET_SIZE];
+  for (size_t i = 0; i < BUCKET_SIZE; ++i)
+    entries[i] = slots[i].load();
+
+  // update the entry of the same position
+  for (size_t i = 0; i < BUCKET_SIZE; ++i) {
+    auto &e = entries[i];
+    if (e.mKey != key or e.empty())
+      continue;
+    if (mPolicy == Replace::DEPTH and e.generation() == mGeneration
+        and depth < e.depth() and bound != Bound::EXACT)
+      return;
+    if (move.isNull())
+      move = e.move();
+    slots[i].save(TransEntry(key, depth, bound, score, move, mGeneration));
+    return;
+  }
+
+  // otherwise replace an empty entry, an entry from an older search, or the
+  // shallowest entry, in that order
+  auto worth = [this](const TransEntry &e) {
+    return e.empty() ? -1
+                     : e.depth() + (e.generation() == mGeneration ? 256 : 0);
+  };
+  auto victim = std::min_element(std::begin(entries), std::end(entries),
+    [&worth](const TransEntry &e1, const TransEntry &e2) {
+      return worth(e1) < worth(e2);
+    });
+
+  if (mPolicy == Replace::DEPTH and not victim->empty()
+      and victim->generation() == mGeneration and depth < victim->depth())
+    return;
+
+  auto entry = TransEntry(key, depth, bound, score, move, mGeneration);
+  slots[victim - std::begin(entries)].save(entry);
+}
+
+//
+// estimate the fill rate
+//
+unsigned
+TransTable::hashfull() const noexcept
+{
+  size_t buckets = std::min(SAMPLE_BUCKETS, mMask + 1);
+  size_t used = 0;
+  for (size_t i = 0; i < buckets; ++i) {
+    for (auto &slot : mBuckets[i].slots) {
+      auto e = slot.load();
+      if (not e.empty() and e.generation() == mGeneration)
+        ++used;
+    }
+  }
+  return used * 1000 / (buckets * BUCKET_SIZE);
+}
+
+} // namespace zoor
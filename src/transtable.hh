@@ -0,0 +1,420 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file transtable.hh
+//! @author Omar A Serrano
+//! @date 2016-10-13
+//! @details The transposition table remembers the result of searching a
+//! position, so that a position reached again through a different sequence of
+//! moves is not searched twice. Positions are found by their Zobrist hash.
+//! The table is one array of buckets, allocated once, with a number of buckets
+//! that is a power of two, so the bucket of a hash is found by masking its low
+//! bits. Each bucket fills a cache line and holds @c TransTable::BUCKET_SIZE
+//! entries. The data of an entry is packed in 64 bits, with the following
+//! layout:
+//! @li bits 0 to 23: the best move, as a @c PackedMove.
+//! @li bits 24 and 25: the bound type of the score.
+//! @li bits 26 to 31: the generation of the search that stored the entry.
+//! @li bits 32 to 39: the depth of the search.
+//! @li bits 48 to 63: the score.
+//!
+//! The table may be shared by threads without locks. Each slot keeps the data
+//! and the hash XORed with the data in two atomic words, which are read and
+//! written independently. If a thread reads the words of two different
+//! stores, the hash recovered from them does not match the hash probed, and
+//! the entry is ignored.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _TRANSTABLE_H
+#define _TRANSTABLE_H
+
+//
+// STL
+//
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+//
+// zoor
+//
+#include "packedmove.hh"
+#include "zobrist.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief The type of bound of a score in the transposition table.
+//! @li NONE if the entry is empty.
+//! @li UPPER if the score is at most the stored score, i.e., no move raised
+//! alpha.
+//! @li LOWER if the score is at least the stored score, i.e., a move failed
+//! high.
+//! @li EXACT if the stored score is the score of the position.
+enum class Bound: uint8_t
+{
+  NONE,
+  UPPER,
+  LOWER,
+  EXACT
+};
+
+//! @brief An entry of the transposition table.
+class TransEntry
+{
+public:
+  //! @brief Alias for the type of the hash.
+  using key_type = Zobrist::key_type;
+
+  //! @brief Alias for the type of the packed data.
+  using data_type = uint64_t;
+
+  //! @brief Default ctor.
+  //! @details Initializes an empty entry.
+  //! @throw Never throws.
+  TransEntry() noexcept;
+
+  //! @brief Constructor.
+  //! @param key The hash of the position.
+  //! @param depth The depth of the search, between 0 and 255.
+  //! @param bound The type of bound of the score.
+  //! @param score The score, between INT16_MIN and INT16_MAX.
+  //! @param move The best move, or the null move if there is none.
+  //! @param generation The generation of the search, between 0 and 63.
+  //! @throw Never throws.
+  TransEntry(key_type key,
+             int depth,
+             Bound bound,
+             int score,
+             PackedMove move,
+             unsigned generation) noexcept;
+
+  //! @return The hash of the position.
+  //! @throw Never throws.
+  key_type
+  key() const noexcept;
+
+  //! @return The packed data.
+  //! @throw Never throws.
+  data_type
+  data() const noexcept;
+
+  //! @return The depth of the search.
+  //! @throw Never throws.
+  int
+  depth() const noexcept;
+
+  //! @return The type of bound of the score.
+  //! @throw Never throws.
+  Bound
+  bound() const noexcept;
+
+  //! @return The score.
+  //! @throw Never throws.
+  int
+  score() const noexcept;
+
+  //! @return The best move, or the null move if there is none.
+  //! @throw Never throws.
+  PackedMove
+  move() const noexcept;
+
+  //! @return The generation of the search that stored the entry.
+  //! @throw Never throws.
+  unsigned
+  generation() const noexcept;
+
+  //! @return True if the entry is empty.
+  //! @throw Never throws.
+  bool
+  empty() const noexcept;
+
+private:
+  friend class TransTable;
+
+  enum {
+    BOUND_SHIFT = 24,
+    GENERATION_SHIFT = 26,
+    DEPTH_SHIFT = 32,
+    SCORE_SHIFT = 48
+  };
+
+  key_type mKey;
+  data_type mData;
+};
+
+//! @brief A transposition table with a fixed number of buckets.
+//! @details The memory for the table is allocated once, when the table is
+//! created or resized, and is not allocated again when entries are stored.
+//! probe() and store() may be called by several threads at once. The other
+//! functions may not be called while a thread is probing or storing.
+class TransTable
+{
+public:
+  //! @brief Alias for the type of the hash.
+  using key_type = TransEntry::key_type;
+
+  //! @brief The number of entries in a bucket.
+  enum { BUCKET_SIZE = 4 };
+
+  //! @brief The policy used to replace an entry.
+  //! @li DEPTH keeps entries from deeper searches of the current generation,
+  //! which are more expensive to recompute, and replaces the shallowest entry
+  //! of a bucket only with an entry of at least the same depth.
+  //! @li ALWAYS replaces the shallowest entry of a bucket with the new entry.
+  enum class Replace
+  {
+    DEPTH,
+    ALWAYS
+  };
+
+  //! @brief Constructor.
+  //! @details Uses as many buckets as fit in the given size, rounded down to a
+  //! power of two, but at least one.
+  //! @param megabytes The memory budget of the table, in MB.
+  //! @param policy The replacement policy.
+  //! @throw std::bad_alloc if the memory cannot be allocated.
+  explicit
+  TransTable(size_t megabytes, Replace policy = Replace::DEPTH);
+
+  //! @brief Change the size of the table.
+  //! @details The entries are lost.
+  //! @param megabytes The memory budget of the table, in MB.
+  //! @throw std::bad_alloc if the memory cannot be allocated.
+  void
+  resize(size_t megabytes);
+
+  //! @brief Remove all the entries.
+  //! @throw Never throws.
+  void
+  clear() noexcept;
+
+  //! @brief Start a new generation.
+  //! @details Called at the start of a search, so that entries left by older
+  //! searches are replaced before entries of the current one.
+  //! @throw Never throws.
+  void
+  newSearch() noexcept;
+
+  //! @brief Find the entry of a position.
+  //! @param key The hash of the position, e.g., @c Board::hashCode().
+  //! @param entry The entry, if found.
+  //! @return True if the entry was found.
+  //! @throw Never throws.
+  bool
+  probe(key_type key, TransEntry &entry) const noexcept;
+
+  //! @brief Store the result of searching a position.
+  //! @details An entry for the same position is always updated, except that
+  //! with the DEPTH policy, an entry from a deeper search is updated only with
+  //! an exact score. The best move of the entry is kept if the new move is
+  //! null.
+  //! @param key The hash of the position, e.g., @c Board::hashCode().
+  //! @param depth The depth of the search, between 0 and 255.
+  //! @param bound The type of bound of the score.
+  //! @param score The score, between INT16_MIN and INT16_MAX.
+  //! @param move The best move, or the null move if there is none.
+  //! @throw Never throws.
+  void
+  store(key_type key, int depth, Bound bound, int score, PackedMove move)
+    noexcept;
+
+  //! @return The number of entries in the table.
+  //! @throw Never throws.
+  size_t
+  size() const noexcept;
+
+  //! @return The replacement policy.
+  //! @throw Never throws.
+  Replace
+  policy() const noexcept;
+
+  //! @brief The fill rate of the table.
+  //! @details Estimated from a sample of the buckets.
+  //! @return The number of entries of the current generation per thousand
+  //! entries.
+  //! @throw Never throws.
+  unsigned
+  hashfull() const noexcept;
+
+private:
+  // an entry, stored as the hash XORed with the data, and the data
+  struct Slot
+  {
+    std::atomic<key_type> xkey;
+    std::atomic<TransEntry::data_type> data;
+
+    Slot() noexcept;
+
+    TransEntry
+    load() const noexcept;
+
+    void
+    save(const TransEntry &entry) noexcept;
+  };
+
+  // a bucket fills a cache line
+  struct alignas(64) Bucket
+  {
+    Slot slots[BUCKET_SIZE];
+  };
+
+  enum { GENERATIONS = 64 };
+
+  const Bucket&
+  bucket(key_type key) const noexcept;
+
+  Bucket&
+  bucket(key_type key) noexcept;
+
+  std::unique_ptr<Bucket[]> mBuckets;
+  size_t mMask;
+  Replace mPolicy;
+  unsigned mGeneration;
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// the hash
+//
+inline TransEntry::key_type
+TransEntry::key() const noexcept
+{
+  return mKey;
+}
+
+//
+// the packed data
+//
+inline TransEntry::data_type
+TransEntry::data() const noexcept
+{
+  return mData;
+}
+
+//
+// the depth
+//
+inline int
+TransEntry::depth() const noexcept
+{
+  return static_cast<uint8_t>(mData >> DEPTH_SHIFT);
+}
+
+//
+// the bound
+//
+inline Bound
+TransEntry::bound() const noexcept
+{
+  return static_cast<Bound>((mData >> BOUND_SHIFT) & 0x3);
+}
+
+//
+// the score
+//
+inline int
+TransEntry::score() const noexcept
+{
+  return static_cast<int16_t>(mData >> SCORE_SHIFT);
+}
+
+//
+// the best move
+//
+inline PackedMove
+TransEntry::move() const noexcept
+{
+  return PackedMove::fromData(mData & 0xffffff);
+}
+
+//
+// the generation
+//
+inline unsigned
+TransEntry::generation() const noexcept
+{
+  return (mData >> GENERATION_SHIFT) & 0x3f;
+}
+
+//
+// is the entry empty
+//
+inline bool
+TransEntry::empty() const noexcept
+{
+  return bound() == Bound::NONE;
+}
+
+//
+// an empty slot
+//
+inline
+TransTable::Slot::Slot() noexcept
+  : xkey(0),
+    data(0) {}
+
+//
+// read the entry of a slot
+//
+inline TransEntry
+TransTable::Slot::load() const noexcept
+{
+  TransEntry entry;
+  entry.mData = data.load(std::memory_order_relaxed);
+  entry.mKey = xkey.load(std::memory_order_relaxed) ^ entry.mData;
+  return entry;
+}
+
+//
+// write the entry of a slot
+//
+inline void
+TransTable::Slot::save(const TransEntry &entry) noexcept
+{
+  xkey.store(entry.mKey ^ entry.mData, std::memory_order_relaxed);
+  data.store(entry.mData, std::memory_order_relaxed);
+}
+
+//
+// the number of entries
+//
+inline size_t
+TransTable::size() const noexcept
+{
+  return (mMask + 1) * BUCKET_SIZE;
+}
+
+//
+// the replacement policy
+//
+inline TransTable::Replace
+TransTable::policy() const noexcept
+{
+  return mPolicy;
+}
+
+//
+// the bucket of a hash
+//
+inline const TransTable::Bucket&
+TransTable::bucket(key_type key) const noexcept
+{
+  return mBuckets[key & mMask];
+}
+
+//
+// the bucket of a hash
+//
+inline TransTable::Bucket&
+TransTable::bucket(key_type key) noexcept
+{
+  return mBuckets[key & mMask];
+}
+
+} // namespace zoor
+#endif // _TRANSTABLE_H
@@ -0,0 +1,66 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file zobrist.cc
+//! @author Omar A Serrano
+//! @date 2016-10-08
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <cstdint>
+
+//
+// zoor
+//
+#include "zobrist.hh"
+
+namespace zoor {
+
+//
+// init static vars
+//
+Zobrist::key_type Zobrist::sPiece[2][6][64];
+Zobrist::key_type Zobrist::sSide;
+Zobrist::key_type Zobrist::sCastle[16];
+Zobrist::key_type Zobrist::sEnPassant[9];
+
+//
+// Fills the keys with a SplitMix64 sequence from a fixed seed. The castling key
+// for no rights and the en passant key for no en passant are left as 0, so that
+// a position without either hashes as if they were not part of the key.
+//
+struct Zobrist::Init
+{
+  Init() noexcept
+  {
+    uint64_t state = 0x7a6f6f72ULL;
+
+    for (auto &colorKeys : sPiece) {
+      for (auto &pieceKeys : colorKeys) {
+        for (auto &key : pieceKeys)
+          key = next(state);
+      }
+    }
+
+    sSide = next(state);
+
+    for (unsigned i = 1; i < 16; ++i)
+      sCastle[i] = next(state);
+
+    for (unsigned i = 1; i < 9; ++i)
+      sEnPassant[i] = next(state);
+  }
+
+  static uint64_t
+  next(uint64_t &state) noexcept
+  {
+    auto z = (state += 0x9e3779b97f4a7c15ULL);
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    return z ^ (z >> 31);
+  }
+};
+
+const Zobrist::Init Zobrist::sInit;
+
+} // namespace zoor
@@ -0,0 +1,139 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file zobrist.hh
+//! @author Omar A Serrano
+//! @date 2016-10-08
+//! @details Random keys used to compute the Zobrist hash of a position. The
+//! hash of a position is the XOR of the key of every piece on its square, the
+//! key for black to move if it is black's turn, the key for the castling
+//! rights, and the key for the en passant column, if any. Since XOR is its own
+//! inverse, the hash can be updated incrementally when a move is made by
+//! XORing in and out only the keys that change.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _ZOBRIST_H
+#define _ZOBRIST_H
+
+//
+// STL
+//
+#include <cassert>
+#include <cstdint>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "bitboard.hh"
+
+namespace zoor {
+
+////////////////////////////////////////////////////////////////////////////////
+// declarations
+////////////////////////////////////////////////////////////////////////////////
+
+//! @brief Zobrist contains the static keys used to hash a position.
+//! @details Copy control for Zobrist has been removed, because it is not meant
+//! to be instantiated. The keys are generated from a fixed seed before main()
+//! runs, so the hash of a position is the same from one run to the next.
+struct Zobrist
+{
+  // Remove copy control
+  Zobrist() = delete;
+  Zobrist(const Zobrist&) = delete;
+  Zobrist(Zobrist&&) = delete;
+  Zobrist& operator=(const Zobrist&) = delete;
+  Zobrist& operator=(Zobrist&&) = delete;
+
+  //! @brief The type of a key and of a hash.
+  using key_type = uint64_t;
+
+  //! @param code The piece code, with a valid piece and color.
+  //! @param index The index of the square where the piece is located.
+  //! @return The key for the piece on the square.
+  //! @throw Never throws.
+  static key_type
+  piece(piece_t code, dim_t index) noexcept;
+
+  //! @return The key XORed into the hash when it is black's turn to move.
+  //! @throw Never throws.
+  static key_type
+  side() noexcept;
+
+  //! @param rights The castling rights, as returned by
+  //! BoardInfo::castleBits().
+  //! @return The key for the castling rights.
+  //! @throw Never throws.
+  static key_type
+  castle(unsigned rights) noexcept;
+
+  //! @param column The column where en passant is possible, or -1 if there is
+  //! no en passant.
+  //! @return The key for the en passant column, or 0 if there is none.
+  //! @throw Never throws.
+  static key_type
+  enPassant(dim_t column) noexcept;
+
+private:
+  // Generates the keys.
+  struct Init;
+
+  // Generates the keys before main() runs.
+  static const Init sInit;
+
+  // Keys for the pieces, indexed by color, piece, and square.
+  static key_type sPiece[2][6][64];
+
+  // Key for black to move.
+  static key_type sSide;
+
+  // Keys for the 16 combinations of castling rights.
+  static key_type sCastle[16];
+
+  // Keys for the en passant column, with no key for no en passant.
+  static key_type sEnPassant[9];
+};
+
+////////////////////////////////////////////////////////////////////////////////
+// definitions
+////////////////////////////////////////////////////////////////////////////////
+
+//
+// key for a piece on a square
+//
+inline Zobrist::key_type
+Zobrist::piece(piece_t code, dim_t index) noexcept
+{
+  assert(index >= 0 and index < 64);
+  return sPiece[colorIndex(getColor(code))][pieceIndex(getPiece(code))][index];
+}
+
+//
+// key for black to move
+//
+inline Zobrist::key_type
+Zobrist::side() noexcept
+{
+  return sSide;
+}
+
+//
+// key for castling rights
+//
+inline Zobrist::key_type
+Zobrist::castle(unsigned rights) noexcept
+{
+  assert(rights < 16);
+  return sCastle[rights];
+}
+
+//
+// key for the en passant column
+//
+inline Zobrist::key_type
+Zobrist::enPassant(dim_t column) noexcept
+{
+  assert(column >= -1 and column < 8);
+  return sEnPassant[column + 1];
+}
+
+} // namespace zoor
+#endif // _ZOBRIST_H
@@ -0,0 +1,38 @@
+////////////////////////////////////////////////////////////////////////////////
+//! @file materialstrategy.hh
+//! @author Omar A Serrano
+//! @date 2016-10-26
+//! @details A strategy for the search tests, whose scores are simple to work
+//! out by hand.
+////////////////////////////////////////////////////////////////////////////////
+#ifndef _MATERIALSTRATEGY_H
+#define _MATERIALSTRATEGY_H
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "istrategy.hh"
+
+namespace zoor {
+
+//! @brief Scores the material of the player to move, with pieceValue().
+struct MaterialStrategy
+  : public IStrategy
+{
+  //! @copydoc IStrategy::score()
+  int
+  score(const Board& board) noexcept override
+  {
+    int total = 0;
+    for (auto code : board) {
+      int value = pieceValue(getPiece(code));
+      total += getColor(code) == board.nextTurn() ? value : -value;
+    }
+    return total;
+  }
+};
+
+} // namespace zoor
+#endif // _MATERIALSTRATEGY_H
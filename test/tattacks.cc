@@ -0,0 +1,170 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tattacks.cc
+//! @author Omar A Serrano
+//! @date 2016-10-15
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <cstdint>
+#include <random>
+
+//
+// zoor
+//
+#include "attacks.hh"
+#include "basictypes.hh"
+#include "bitboard.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+namespace {
+
+//
+// the squares attacked along the rays, walking one square at a time
+//
+bitboard_t
+walk(dim_t index, bitboard_t occupied, const int (&dirs)[4][2])
+{
+  bitboard_t bits = 0;
+  for (auto &dir : dirs) {
+    int row = index / 8 + dir[0];
+    int col = index % 8 + dir[1];
+    for (; row >= 0 and row < 8 and col >= 0 and col < 8;
+         row += dir[0], col += dir[1]) {
+      bits |= squareMask(row, col);
+      if (occupied & squareMask(row, col))
+        break;
+    }
+  }
+  return bits;
+}
+
+const int DIAGONAL[4][2] = {{1, 1}, {-1, 1}, {-1, -1}, {1, -1}};
+const int STRAIGHT[4][2] = {{1, 0}, {0, 1}, {-1, 0}, {0, -1}};
+
+} // namespace
+
+//
+// test the knight attacks
+//
+TEST(Attacks, Knight)
+{
+  EXPECT_EQ(squareMask(1, 2) | squareMask(2, 1), Attacks::knight(0));
+  EXPECT_EQ(8, popCount(Attacks::knight(squareIndex(3, 3))));
+  EXPECT_EQ(squareMask(5, 6) | squareMask(6, 5), Attacks::knight(63));
+
+  // every pair of squares a knight's jump apart, counted from both ends
+  int total = 0;
+  for (dim_t i = 0; i < 64; ++i)
+    total += popCount(Attacks::knight(i));
+  EXPECT_EQ(336, total);
+}
+
+//
+// test the king attacks
+//
+TEST(Attacks, King)
+{
+  EXPECT_EQ(squareMask(0, 1) | squareMask(1, 0) | squareMask(1, 1),
+            Attacks::king(0));
+  EXPECT_EQ(8, popCount(Attacks::king(squareIndex(4, 4))));
+  EXPECT_EQ(5, popCount(Attacks::king(squareIndex(0, 4))));
+
+  int total = 0;
+  for (dim_t i = 0; i < 64; ++i)
+    total += popCount(Attacks::king(i));
+  EXPECT_EQ(420, total);
+}
+
+//
+// test the pawn attacks
+//
+TEST(Attacks, Pawn)
+{
+  auto e4 = squareIndex(3, 4);
+  EXPECT_EQ(squareMask(4, 3) | squareMask(4, 5), Attacks::pawn(Color::W, e4));
+  EXPECT_EQ(squareMask(2, 3) | squareMask(2, 5), Attacks::pawn(Color::B, e4));
+
+  // pawns on the edge columns attack one square
+  EXPECT_EQ(squareMask(2, 1), Attacks::pawn(Color::W, squareIndex(1, 0)));
+  EXPECT_EQ(squareMask(5, 6), Attacks::pawn(Color::B, squareIndex(6, 7)));
+
+  // nothing beyond the last row
+  EXPECT_EQ(0, Attacks::pawn(Color::W, squareIndex(7, 3)));
+  EXPECT_EQ(0, Attacks::pawn(Color::B, squareIndex(0, 3)));
+}
+
+//
+// test the sliding attacks
+//
+TEST(Attacks, Sliders)
+{
+  // a rook on a1 of an empty board
+  EXPECT_EQ(0x01010101010101feULL, Attacks::rook(0, 0));
+  EXPECT_EQ(14, popCount(Attacks::rook(squareIndex(3, 3), 0)));
+  EXPECT_EQ(13, popCount(Attacks::bishop(squareIndex(3, 3), 0)));
+
+  // blockers are attacked, the squares behind them are not
+  auto d4 = squareIndex(3, 3);
+  auto occupied = squareMask(3, 5) | squareMask(5, 5) | squareMask(1, 3);
+  EXPECT_EQ(squareMask(3, 4) | squareMask(3, 5), Attacks::rook(d4, occupied)
+            & (squareMask(3, 4) | squareMask(3, 5) | squareMask(3, 6)));
+  EXPECT_EQ(Attacks::rook(d4, occupied) | Attacks::bishop(d4, occupied),
+            Attacks::queen(d4, occupied));
+
+  // the tables match walking the rays, for random occupied squares
+  std::mt19937_64 gen(2016);
+  for (int i = 0; i < 2000; ++i) {
+    bitboard_t occ = gen() & gen();
+    for (dim_t index = 0; index < 64; ++index) {
+      ASSERT_EQ(walk(index, occ, DIAGONAL), Attacks::bishop(index, occ))
+        << "\tBishop on " << index << ", occupied " << occ;
+      ASSERT_EQ(walk(index, occ, STRAIGHT), Attacks::rook(index, occ))
+        << "\tRook on " << index << ", occupied " << occ;
+    }
+  }
+}
+
+//
+// test the squares between two squares, and the lines through them
+//
+TEST(Attacks, BetweenAndLine)
+{
+  auto a1 = squareIndex(0, 0);
+  auto h8 = squareIndex(7, 7);
+  auto e1 = squareIndex(0, 4);
+  auto e8 = squareIndex(7, 4);
+
+  EXPECT_EQ(0x0040201008040200ULL, Attacks::between(a1, h8));
+  EXPECT_EQ(Attacks::between(a1, h8), Attacks::between(h8, a1));
+  EXPECT_EQ(0x8040201008040201ULL, Attacks::line(a1, h8));
+  EXPECT_EQ(0x0010101010101000ULL, Attacks::between(e1, e8));
+  EXPECT_EQ(0x1010101010101010ULL, Attacks::line(e1, squareIndex(3, 4)));
+
+  // next to each other, or not on a line
+  EXPECT_EQ(0, Attacks::between(e1, squareIndex(1, 4)));
+  EXPECT_EQ(0, Attacks::between(e1, squareIndex(2, 5)));
+  EXPECT_EQ(0, Attacks::line(e1, squareIndex(2, 5)));
+  EXPECT_EQ(0, Attacks::line(e1, e1));
+
+  // the squares between are on the line
+  for (dim_t from = 0; from < 64; ++from) {
+    for (dim_t to = 0; to < 64; ++to) {
+      auto between = Attacks::between(from, to);
+      ASSERT_EQ(between, between & Attacks::line(from, to));
+      // the squares attacked from both ends
+      auto both = Attacks::queen(from, squareMask(to))
+                & Attacks::queen(to, squareMask(from));
+      ASSERT_EQ(between, both & Attacks::line(from, to));
+    }
+  }
+}
+
+} // namespace zoor
@@ -7,6 +7,7 @@
 //
 // STL
 //
+#include <type_traits>
 #include <utility>
 
 //
@@ -219,11 +220,62 @@ TEST(BasicBoard, MoveAssign)
   EXPECT_EQ(board1.get(0, 0), 0);
   EXPECT_EQ(board2.get(0, 1), 0);
 
+  // moving is the same as copying, the moved board is unchanged
   board2 = move(board1);
-  EXPECT_EQ(board1.get(0, 1), 0);
-  EXPECT_NE(board1.get(0, 0), 0);
+  EXPECT_EQ(board1.get(0, 0), 0);
+  EXPECT_NE(board1.get(0, 1), 0);
   EXPECT_EQ(board2.get(0, 0), 0);
   EXPECT_NE(board2.get(0, 1), 0);
+  EXPECT_EQ(board1, board2);
+}
+
+//
+// boards are trivially copyable
+//
+TEST(BasicBoard, TriviallyCopyable)
+{
+  EXPECT_TRUE(std::is_trivially_copyable<BasicBoard>::value);
+  EXPECT_EQ(0, alignof(BasicBoard) % 64);
+}
+
+//
+// test bitboards are in sync with the squares
+//
+TEST(BasicBoard, Bits)
+{
+  BasicBoard board;
+  auto &bits = board.bits();
+
+  EXPECT_EQ(0xffffULL, bits.color(Color::W));
+  EXPECT_EQ(0xffff000000000000ULL, bits.color(Color::B));
+  EXPECT_EQ(0xff00ULL, bits.pieces(Color::W, Piece::P));
+  EXPECT_EQ(0x00ff000000000000ULL, bits.pieces(Color::B, Piece::P));
+  EXPECT_EQ(squareMask(0, 4), bits.pieces(Color::W, Piece::K));
+  EXPECT_EQ(squareMask(7, 3), bits.pieces(Color::B, Piece::Q));
+
+  // replace a piece
+  board.put(0, 0, Piece::Q, Color::B);
+  EXPECT_EQ(0, bits.pieces(Color::W, Piece::R) & squareMask(0, 0));
+  EXPECT_NE(0, bits.pieces(Color::B, Piece::Q) & squareMask(0, 0));
+  EXPECT_EQ(0, bits.color(Color::W) & squareMask(0, 0));
+
+  // clear pieces
+  board.clear(0, 0);
+  board.clear(1, 4);
+  EXPECT_EQ(0, bits.occupied() & squareMask(0, 0));
+  EXPECT_EQ(0, bits.occupied() & squareMask(1, 4));
+  EXPECT_EQ(30, popCount(bits.occupied()));
+
+  // put a piece on an empty square
+  board.put(3, 4, Color::W | Piece::P);
+  EXPECT_NE(0, bits.pieces(Color::W, Piece::P) & squareMask(3, 4));
+
+  // an empty board has empty bitboards
+  EXPECT_EQ(0, BasicBoard::emptyBoard().bits().occupied());
+
+  // copies have the same bitboards
+  BasicBoard board2(board);
+  EXPECT_EQ(board.bits(), board2.bits());
 }
 
 //
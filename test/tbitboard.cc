@@ -0,0 +1,131 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tbitboard.cc
+//! @author Omar A Serrano
+//! @date 2016-10-02
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "bitboard.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// test squareIndex and squareMask
+//
+TEST(BitBoard, SquareIndexAndMask)
+{
+  EXPECT_EQ(0, squareIndex(0, 0));
+  EXPECT_EQ(7, squareIndex(0, 7));
+  EXPECT_EQ(56, squareIndex(7, 0));
+  EXPECT_EQ(63, squareIndex(7, 7));
+  EXPECT_EQ(28, squareIndex(3, 4));
+
+  EXPECT_EQ(bitboard_t(1), squareMask(0, 0));
+  EXPECT_EQ(bitboard_t(1) << 63, squareMask(7, 7));
+  EXPECT_EQ(squareMask(3, 4), squareMask(28));
+}
+
+//
+// test popCount, lsbIndex, and popLsb
+//
+TEST(BitBoard, BitOperations)
+{
+  EXPECT_EQ(0, popCount(0));
+  EXPECT_EQ(64, popCount(~bitboard_t(0)));
+
+  bitboard_t bits = squareMask(1, 2) | squareMask(4, 4) | squareMask(7, 7);
+  EXPECT_EQ(3, popCount(bits));
+  EXPECT_EQ(squareIndex(1, 2), lsbIndex(bits));
+
+  EXPECT_EQ(squareIndex(1, 2), popLsb(bits));
+  EXPECT_EQ(squareIndex(4, 4), popLsb(bits));
+  EXPECT_EQ(squareIndex(7, 7), popLsb(bits));
+  EXPECT_EQ(0, bits);
+}
+
+//
+// test colorIndex and pieceIndex
+//
+TEST(BitBoard, Indexes)
+{
+  EXPECT_EQ(0, colorIndex(Color::W));
+  EXPECT_EQ(1, colorIndex(Color::B));
+
+  EXPECT_EQ(0, pieceIndex(Piece::P));
+  EXPECT_EQ(1, pieceIndex(Piece::N));
+  EXPECT_EQ(2, pieceIndex(Piece::B));
+  EXPECT_EQ(3, pieceIndex(Piece::R));
+  EXPECT_EQ(4, pieceIndex(Piece::Q));
+  EXPECT_EQ(5, pieceIndex(Piece::K));
+}
+
+//
+// test default ctor
+//
+TEST(BitBoard, DefaultCtor)
+{
+  BitBoard bits;
+  EXPECT_EQ(0, bits.occupied());
+  EXPECT_EQ(~bitboard_t(0), bits.empty());
+  EXPECT_EQ(0, bits.color(Color::W));
+  EXPECT_EQ(0, bits.color(Color::B));
+  EXPECT_EQ(0, bits.pieces(Piece::K));
+}
+
+//
+// test add and remove
+//
+TEST(BitBoard, AddAndRemove)
+{
+  BitBoard bits;
+  auto e1 = squareIndex(0, 4);
+  auto e8 = squareIndex(7, 4);
+  auto d4 = squareIndex(3, 3);
+
+  bits.add(e1, Color::W | Piece::K);
+  bits.add(e8, Color::B | Piece::K);
+  bits.add(d4, Color::B | Piece::Q);
+
+  EXPECT_EQ(squareMask(e1), bits.pieces(Color::W, Piece::K));
+  EXPECT_EQ(squareMask(e8), bits.pieces(Color::B, Piece::K));
+  EXPECT_EQ(squareMask(e1) | squareMask(e8), bits.pieces(Piece::K));
+  EXPECT_EQ(squareMask(d4), bits.pieces(Color::B, Piece::Q));
+  EXPECT_EQ(0, bits.pieces(Color::W, Piece::Q));
+  EXPECT_EQ(squareMask(e1), bits.color(Color::W));
+  EXPECT_EQ(squareMask(e8) | squareMask(d4), bits.color(Color::B));
+  EXPECT_EQ(3, popCount(bits.occupied()));
+
+  bits.remove(d4, Color::B | Piece::Q);
+  EXPECT_EQ(0, bits.pieces(Color::B, Piece::Q));
+  EXPECT_EQ(squareMask(e8), bits.color(Color::B));
+  EXPECT_EQ(2, popCount(bits.occupied()));
+}
+
+//
+// test equality operator
+//
+TEST(BitBoard, EqualOp)
+{
+  BitBoard bits1, bits2;
+  EXPECT_EQ(bits1, bits2);
+
+  bits1.add(0, Color::W | Piece::R);
+  EXPECT_NE(bits1, bits2);
+
+  bits2.add(0, Color::W | Piece::R);
+  EXPECT_EQ(bits1, bits2);
+
+  bits1.remove(0, Color::W | Piece::R);
+  bits1.add(0, Color::W | Piece::Q);
+  EXPECT_NE(bits1, bits2);
+}
+
+} // namespace zoor
@@ -8,6 +8,7 @@
 // STL
 //
 #include <algorithm>
+#include <functional>
 #include <sstream>
 #include <string>
 #include <utility>
@@ -17,9 +18,12 @@
 // zoor
 //
 #include "basictypes.hh"
+#include "bitboard.hh"
 #include "board.hh"
 #include "fenrecord.hh"
 #include "iofen.hh"
+#include "movelist.hh"
+#include "moveundo.hh"
 #include "piecemove.hh"
 #include "square.hh"
 
@@ -38,6 +42,7 @@ using std::pair;
 using std::vector;
 
 void playViennaGame(vector<PieceMove> &moveList);
+Board rebuildBoard(const Board &board);
 
 //
 // test Board default ctor
@@ -693,6 +698,65 @@ TEST(Board, MakeMove)
 
     EXPECT_EQ(board.base(), pb->base())
       << "\tBoards are not equal after move: " << pm;
+
+    EXPECT_EQ(board.base().bits(), pb->base().bits())
+      << "\tBitboards are not equal after move: " << pm;
+  }
+}
+
+//
+// test makeMove with undo and unmakeMove
+//
+TEST(Board, UnmakeMove)
+{
+  // positions with castling, en passant, promotions, and captures
+  auto fenNames = {
+    "fen/makeMove.fen", "fen/canWhiteCastle.fen", "fen/canBlackCastle.fen",
+    "fen/enPassantForWhite.fen", "fen/enPassantForBlack.fen",
+    "fen/moveWhitePawn.fen", "fen/moveBlackPawn.fen"
+  };
+
+  for (auto fenName : fenNames) {
+    for (auto &fen : readFen(fenName)) {
+      auto board = *fen.boardPtr();
+      const auto before = board;
+      for (auto &pm : board.getMoves()) {
+        MoveUndo undo;
+        board.makeMove(pm, undo);
+        EXPECT_EQ(before.makeMoveCopy(pm), board)
+          << "\tBoards are not equal after move: " << pm;
+        EXPECT_EQ(before.makeMoveCopy(pm).hashCode(), board.hashCode())
+          << "\tHash is not equal after move: " << pm;
+
+        board.unmakeMove(undo);
+        EXPECT_EQ(before, board)
+          << "\tBoards are not equal after unmaking move: " << pm;
+        EXPECT_EQ(before.base().bits(), board.base().bits())
+          << "\tBitboards are not equal after unmaking move: " << pm;
+        EXPECT_EQ(before.lastMove(), board.lastMove())
+          << "\tLast move is not equal after unmaking move: " << pm;
+        EXPECT_EQ(before.hashCode(), board.hashCode())
+          << "\tHash is not equal after unmaking move: " << pm;
+        EXPECT_EQ(before.psqt(), board.psqt())
+          << "\tPiece-square sums are not equal after unmaking move: " << pm;
+      }
+    }
+  }
+
+  // take back a whole game
+  vector<PieceMove> moveList;
+  playViennaGame(moveList);
+  vector<MoveUndo> undoList(moveList.size());
+  vector<Board> boardList;
+  Board board;
+  for (size_t i = 0; i < moveList.size(); ++i) {
+    boardList.push_back(board);
+    board.makeMove(moveList[i], undoList[i]);
+  }
+  for (size_t i = moveList.size(); i > 0; --i) {
+    board.unmakeMove(undoList[i-1]);
+    EXPECT_EQ(boardList[i-1], board);
+    EXPECT_EQ(boardList[i-1].hashCode(), board.hashCode());
   }
 }
 
@@ -1821,6 +1885,136 @@ TEST(Board, HashCode)
   PieceMove pm(1, 0, Color::W|Piece::P, 3, 0);
   board2.makeMove(pm);
   EXPECT_NE(board1.hashCode(), board2.hashCode());
+
+  // the incremental hash is the same as the hash of a new board
+  vector<PieceMove> moveList;
+  playViennaGame(moveList);
+  Board board;
+  for (auto &pm : moveList) {
+    board.makeMove(pm);
+    EXPECT_EQ(rebuildBoard(board).hashCode(), board.hashCode())
+      << "\tHash is not equal after move: " << pm;
+    for (auto &child : board.getBoards())
+      EXPECT_EQ(rebuildBoard(child).hashCode(), child.hashCode())
+        << "\tHash is not equal after move: " << child.lastMove();
+  }
+
+  // the same position reached with different moves has the same hash
+  board = Board();
+  board.makeMove(PieceMove(0, 6, Color::W|Piece::N, 2, 5));
+  board.makeMove(PieceMove(7, 6, Color::B|Piece::N, 5, 5));
+  board.makeMove(PieceMove(2, 5, Color::W|Piece::N, 0, 6));
+  board.makeMove(PieceMove(5, 5, Color::B|Piece::N, 7, 6));
+  EXPECT_EQ(Board(), board);
+  EXPECT_EQ(Board().hashCode(), board.hashCode());
+}
+
+//
+// test that the hash covers castling rights and en passant
+//
+TEST(Board, HashCodeCastleAndEnPassant)
+{
+  vector<Square> squareList = {
+    {0, 4, Piece::K, Color::W}, {0, 7, Piece::R, Color::W},
+    {4, 4, Piece::P, Color::W}, {6, 3, Piece::P, Color::B},
+    {7, 4, Piece::K, Color::B}
+  };
+
+  // castling rights
+  BoardInfo info;
+  Board board1(squareList, Color::W, info, PieceMove());
+  info.rookH1On();
+  Board board2(squareList, Color::W, info, PieceMove());
+  EXPECT_NE(board1, board2);
+  EXPECT_NE(board1.hashCode(), board2.hashCode());
+
+  // a check does not change the castling rights
+  BoardInfo infoCheck;
+  infoCheck.wkCheckSet(true);
+  Board board3(squareList, Color::W, infoCheck, PieceMove());
+  EXPECT_EQ(board1.hashCode(), board3.hashCode());
+
+  // en passant is only part of the hash if the capture is possible
+  board1 = Board(squareList, Color::B, BoardInfo(), PieceMove());
+  board1.makeMove(PieceMove(6, 3, Color::B|Piece::P, 4, 3));
+  EXPECT_EQ(3, board1.enPassantColumn());
+  EXPECT_EQ(rebuildBoard(board1).hashCode(), board1.hashCode());
+
+  squareList[3] = Square(4, 3, Piece::P, Color::B);
+  board2 = Board(squareList, Color::W, BoardInfo(), PieceMove());
+  EXPECT_EQ(-1, board2.enPassantColumn());
+  EXPECT_EQ(board1.base(), board2.base());
+  EXPECT_NE(board1, board2);
+  EXPECT_NE(board1.hashCode(), board2.hashCode());
+
+  squareList[2] = Square(4, 6, Piece::P, Color::W);
+  squareList[3] = Square(6, 3, Piece::P, Color::B);
+  board1 = Board(squareList, Color::B, BoardInfo(), PieceMove());
+  board1.makeMove(PieceMove(6, 3, Color::B|Piece::P, 4, 3));
+  squareList[3] = Square(4, 3, Piece::P, Color::B);
+  board2 = Board(squareList, Color::W, BoardInfo(), PieceMove());
+  EXPECT_EQ(-1, board1.enPassantColumn());
+  EXPECT_EQ(board1, board2);
+  EXPECT_EQ(board1.hashCode(), board2.hashCode());
+}
+
+//
+// test the piece-square sums
+//
+TEST(Board, Psqt)
+{
+  // the starting position is the same for both players
+  Board board;
+  EXPECT_EQ(0, board.psqtScore());
+  EXPECT_EQ(Psqt::PHASE_MAX, board.psqt().phase);
+  EXPECT_EQ(board.psqt().midgame[0], board.psqt().midgame[1]);
+  EXPECT_EQ(board.psqt().endgame[0], board.psqt().endgame[1]);
+
+  // the incremental sums are the same as the sums of a new board
+  vector<PieceMove> moveList;
+  playViennaGame(moveList);
+  for (auto &pm : moveList) {
+    board.makeMove(pm);
+    EXPECT_EQ(rebuildBoard(board).psqt(), board.psqt())
+      << "\tPiece-square sums are not equal after move: " << pm;
+    for (auto &child : board.getBoards())
+      EXPECT_EQ(rebuildBoard(child).psqt(), child.psqt())
+        << "\tPiece-square sums are not equal after move: " << child.lastMove();
+  }
+
+  // a position and its mirror image score the same for the player to move
+  vector<Square> squareList = {
+    {0, 6, Piece::K, Color::W}, {1, 5, Piece::P, Color::W},
+    {3, 4, Piece::N, Color::W}, {7, 1, Piece::K, Color::B},
+    {4, 2, Piece::P, Color::B}
+  };
+  vector<Square> mirrorList;
+  for (auto &sq : squareList)
+    mirrorList.emplace_back(7 - sq.row(), sq.column(), sq.piece(), ~sq.color());
+  Board board1(squareList, Color::W, BoardInfo(), PieceMove());
+  Board board2(mirrorList, Color::B, BoardInfo(), PieceMove());
+  EXPECT_LT(0, board1.psqtScore());
+  EXPECT_EQ(board1.psqtScore(), board2.psqtScore());
+  EXPECT_EQ(1, board1.psqt().phase);
+
+  // promotions and captures change the phase
+  squareList = {
+    {0, 4, Piece::K, Color::W}, {6, 0, Piece::P, Color::W},
+    {7, 4, Piece::K, Color::B}, {7, 1, Piece::R, Color::B}
+  };
+  Board board3(squareList, Color::W, BoardInfo(), PieceMove());
+  EXPECT_EQ(2, board3.psqt().phase);
+  PieceMove pm(6, 0, Color::W|Piece::P, 7, 1);
+  pm.xPiece(7, 1, Piece::R, Color::B);
+  pm.dPiece(Piece::Q);
+  ASSERT_TRUE(board3.isLegal(pm));
+  MoveUndo undo;
+  auto before = board3.psqt();
+  board3.makeMove(pm, undo);
+  EXPECT_EQ(4, board3.psqt().phase);
+  EXPECT_EQ(rebuildBoard(board3).psqt(), board3.psqt());
+  board3.unmakeMove(undo);
+  EXPECT_EQ(before, board3.psqt());
 }
 
 //
@@ -1847,6 +2041,320 @@ TEST(Board, EqualOp)
   EXPECT_TRUE(board1 != board2);
 }
 
+//
+// test checkers and inCheck
+//
+TEST(Board, Checkers)
+{
+  Board board;
+  EXPECT_EQ(0, board.checkers());
+  EXPECT_FALSE(board.inCheck());
+
+  // a bishop on b4 gives check
+  board = *readFenLine("4k3/8/8/8/1b6/8/8/4K2R w K - 0 1").boardPtr();
+  EXPECT_EQ(squareMask(3, 1), board.checkers());
+  EXPECT_TRUE(board.inCheck());
+  EXPECT_TRUE(board.kingInfo().wkCheck());
+  EXPECT_TRUE(board.isKingAttacked(Color::W));
+
+  // the check is gone after the king moves, and back after the move is undone
+  MoveUndo undo;
+  board.makeMove(PieceMove(0, 4, Color::W|Piece::K, 1, 5), undo);
+  EXPECT_FALSE(board.inCheck());
+  EXPECT_FALSE(board.kingInfo().wkCheck());
+  EXPECT_FALSE(board.kingInfo().bkCheck());
+  board.unmakeMove(undo);
+  EXPECT_EQ(squareMask(3, 1), board.checkers());
+  EXPECT_TRUE(board.kingInfo().wkCheck());
+
+  // a rook move gives check to the other king
+  board.makeMove(PieceMove(0, 4, Color::W|Piece::K, 0, 5));
+  board.makeMove(PieceMove(3, 1, Color::B|Piece::B, 4, 2));
+  board.makeMove(PieceMove(0, 7, Color::W|Piece::R, 7, 7));
+  EXPECT_EQ(squareMask(7, 7), board.checkers());
+  EXPECT_TRUE(board.kingInfo().bkCheck());
+  EXPECT_FALSE(board.kingInfo().wkCheck());
+
+  // double check
+  board = *readFenLine("4k3/4r3/8/8/1b6/8/8/4K3 w - - 0 1").boardPtr();
+  EXPECT_EQ(2, popCount(board.checkers()));
+}
+
+//
+// test that the legal moves are the moves that do not leave the king in check
+//
+TEST(Board, GetLegalMoves)
+{
+  // a pinned knight cannot move, and a pinned rook moves along the pin
+  auto board = *readFenLine("4k3/8/8/b7/4r3/8/3NR3/4K3 w - - 0 1").boardPtr();
+  auto moveList = board.getLegalMoves();
+  EXPECT_EQ(0, std::count_if(moveList.begin(), moveList.end(),
+    [](const PieceMove &pm) { return pm.sPiece() == Piece::N; }));
+  EXPECT_EQ(2, std::count_if(moveList.begin(), moveList.end(),
+    [](const PieceMove &pm) { return pm.sPiece() == Piece::R; }));
+
+  // in check, a piece can only capture the checking piece or block the check
+  board = *readFenLine("4k3/8/8/8/4r3/8/3N4/R3K3 w - - 0 1").boardPtr();
+  ASSERT_TRUE(board.inCheck());
+  PieceMove capture(1, 3, Color::W|Piece::N, 3, 4);
+  capture.xPiece(3, 4, Piece::R, Color::B);
+  for (auto &pm : board.getLegalMoves()) {
+    if (pm.sPiece() != Piece::K) {
+      EXPECT_EQ(capture, pm);
+    }
+  }
+
+  // in double check, only the king can move
+  board = *readFenLine("4k3/4r3/8/8/1b6/8/3N4/4K3 w - - 0 1").boardPtr();
+  moveList = board.getLegalMoves();
+  ASSERT_FALSE(moveList.empty());
+  for (auto &pm : moveList)
+    EXPECT_EQ(Piece::K, pm.sPiece());
+
+  // the en passant capture would leave the king in check along the row
+  board = *readFenLine("8/8/8/K2pP2r/8/8/8/7k w - d6 0 1").boardPtr();
+  moveList = board.getLegalMoves();
+  EXPECT_EQ(0, std::count_if(moveList.begin(), moveList.end(),
+    [](const PieceMove &pm) { return pm.isEnPassant(); }));
+
+  // compare with making the moves, for every position two moves deep
+  const char *fenList[] = {
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+  };
+  std::function<void(Board&, int)> compare = [&](Board &b, int depth) {
+    vector<PieceMove> expected;
+    for (auto &pm : b.getMoves()) {
+      MoveUndo undo;
+      b.makeMove(pm, undo);
+      if (not b.isKingAttacked(~b.nextTurn()))
+        expected.push_back(pm);
+      b.unmakeMove(undo);
+    }
+    ASSERT_EQ(expected, b.getLegalMoves()) << "\t" << b;
+    if (depth == 0)
+      return;
+    for (auto &pm : expected) {
+      MoveUndo undo;
+      b.makeMove(pm, undo);
+      compare(b, depth - 1);
+      b.unmakeMove(undo);
+    }
+  };
+  for (auto fen : fenList) {
+    board = *readFenLine(fen).boardPtr();
+    compare(board, 2);
+  }
+}
+
+//
+// test hasLegalMove and countLegalMoves
+//
+TEST(Board, CountLegalMoves)
+{
+  // checkmate and stalemate
+  auto board = *readFenLine("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1").boardPtr();
+  EXPECT_TRUE(board.hasLegalMove());
+  board.makeMove(PieceMove(0, 0, Color::W|Piece::R, 7, 0));
+  EXPECT_TRUE(board.inCheck());
+  EXPECT_FALSE(board.hasLegalMove());
+  EXPECT_EQ(0, board.countLegalMoves());
+  board = *readFenLine("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1").boardPtr();
+  EXPECT_FALSE(board.inCheck());
+  EXPECT_FALSE(board.hasLegalMove());
+  EXPECT_EQ(0, board.countLegalMoves());
+
+  // the same count as the generated moves, for every position two moves deep
+  const char *fenList[] = {
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+    "8/8/8/K2pP2r/8/8/8/7k w - d6 0 1"
+  };
+  std::function<void(Board&, int)> compare = [&](Board &b, int depth) {
+    MoveList moveList;
+    b.getLegalMoves(moveList);
+    ASSERT_EQ(static_cast<int>(moveList.size()), b.countLegalMoves())
+      << "\t" << b;
+    ASSERT_EQ(not moveList.empty(), b.hasLegalMove()) << "\t" << b;
+    if (depth == 0)
+      return;
+    for (auto &pm : moveList) {
+      MoveUndo undo;
+      b.makeMove(pm, undo);
+      compare(b, depth - 1);
+      b.unmakeMove(undo);
+    }
+  };
+  for (auto fen : fenList) {
+    board = *readFenLine(fen).boardPtr();
+    compare(board, 2);
+  }
+}
+
+//
+// test that the captures and the quiet moves make up the legal moves
+//
+TEST(Board, GetLegalMovesByType)
+{
+  const char *fenList[] = {
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "8/8/8/K2pP2r/8/8/8/7k w - d6 0 1",
+    "4k3/8/8/8/3pP3/8/8/4K3 b - e3 0 1"
+  };
+  for (auto fen : fenList) {
+    auto board = *readFenLine(fen).boardPtr();
+    MoveList captures, quiets;
+    board.getLegalMoves(captures, Board::GenType::CAPTURES);
+    board.getLegalMoves(quiets, Board::GenType::QUIETS);
+
+    for (auto &pm : captures)
+      EXPECT_TRUE(pm.isCapture() or pm.isPromo()) << "\t" << pm;
+    for (auto &pm : quiets)
+      EXPECT_FALSE(pm.isCapture() or pm.isPromo()) << "\t" << pm;
+
+    auto legalList = board.getLegalMoves();
+    EXPECT_EQ(legalList.size(), captures.size() + quiets.size()) << "\t" << fen;
+    for (auto moves : {&captures, &quiets}) {
+      for (auto &pm : *moves) {
+        EXPECT_NE(legalList.end(),
+                  std::find(legalList.begin(), legalList.end(), pm));
+      }
+    }
+  }
+}
+
+//
+// test that moves are checked as the move generators would check them
+//
+TEST(Board, IsLegal)
+{
+  // castling through an attacked square
+  auto board = *readFenLine("1r2k3/8/8/8/8/8/5r2/R3K2R w KQ - 0 1").boardPtr();
+  PieceMove castle(0, 4, Color::W|Piece::K, 0, 6);
+  castle.xPiece(0, 7, Piece::R, Color::W);
+  PieceMove castleLong(0, 4, Color::W|Piece::K, 0, 2);
+  castleLong.xPiece(0, 0, Piece::R, Color::W);
+  EXPECT_FALSE(board.isPseudoLegal(castle));
+  EXPECT_TRUE(board.isLegal(castleLong));
+
+  // a rook cannot jump, and a king cannot step into check
+  EXPECT_FALSE(board.isPseudoLegal(PieceMove(0, 0, Color::W|Piece::R, 0, 5)));
+  EXPECT_TRUE(board.isPseudoLegal(PieceMove(0, 4, Color::W|Piece::K, 1, 4)));
+  EXPECT_FALSE(board.isLegal(PieceMove(0, 4, Color::W|Piece::K, 1, 4)));
+
+  // a capture must name the captured piece, and a promotion its piece
+  board = *readFenLine("1n2k3/P7/8/8/8/8/8/4K3 w - - 0 1").boardPtr();
+  PieceMove promo(6, 0, Color::W|Piece::P);
+  promo.xPiece(7, 1, Color::B|Piece::N);
+  promo.dPiece(7, 1, Piece::Q, Color::W);
+  EXPECT_TRUE(board.isLegal(promo));
+  promo.xPiece(7, 1, Color::B|Piece::B);
+  EXPECT_FALSE(board.isLegal(promo));
+  EXPECT_FALSE(board.isLegal(PieceMove(6, 0, Color::W|Piece::P, 7, 0)));
+
+  // making a move that is not pseudo legal throws
+  EXPECT_THROW(board.makeMove(PieceMove(6, 0, Color::W|Piece::P, 7, 0)),
+               ChessError);
+
+  // en passant is only for a pawn beside the pawn that moved two squares
+  board = *readFenLine("4k3/8/8/2pP4/8/8/8/4K3 w - c6 0 1").boardPtr();
+  PieceMove enPassant(4, 3, Color::W|Piece::P, 5, 2);
+  enPassant.xPiece(4, 2, Color::B|Piece::P);
+  EXPECT_TRUE(board.isLegal(enPassant));
+  board = *readFenLine("4k3/8/3P4/2p5/8/8/8/4K3 w - c6 0 1").boardPtr();
+  PieceMove farCapture(5, 3, Color::W|Piece::P, 6, 2);
+  EXPECT_FALSE(board.isPseudoLegal(farCapture));
+  EXPECT_FALSE(board.isLegal(farCapture));
+  EXPECT_THROW(board.makeMove(farCapture), ChessError);
+  farCapture.xPiece(5, 2, Color::B|Piece::P);
+  EXPECT_FALSE(board.isPseudoLegal(farCapture));
+
+  // compare with the move generators, for the moves of the position and of
+  // the position before it, every position two moves deep
+  const char *fenList[] = {
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+  };
+  auto contains = [](const vector<PieceMove> &moveList, const PieceMove &pm) {
+    return std::find(moveList.begin(), moveList.end(), pm) != moveList.end();
+  };
+  std::function<void(Board&, const vector<PieceMove>&, int)> compare =
+    [&](Board &b, const vector<PieceMove> &before, int depth) {
+      auto moveList = b.getMoves();
+      auto legalList = b.getLegalMoves();
+      const vector<PieceMove> *lists[] = {&moveList, &before};
+      for (auto moves : lists) {
+        for (auto &pm : *moves) {
+          ASSERT_EQ(contains(moveList, pm), b.isPseudoLegal(pm))
+            << "\t" << pm << "\n" << b;
+          ASSERT_EQ(contains(legalList, pm), b.isLegal(pm))
+            << "\t" << pm << "\n" << b;
+        }
+      }
+      if (depth == 0)
+        return;
+      for (auto &pm : legalList) {
+        MoveUndo undo;
+        b.makeMove(pm, undo);
+        compare(b, moveList, depth - 1);
+        b.unmakeMove(undo);
+      }
+    };
+  for (auto fen : fenList) {
+    board = *readFenLine(fen).boardPtr();
+    compare(board, vector<PieceMove>(), 2);
+  }
+}
+
+//
+// test that a king that moves loses its castling rights
+//
+TEST(Board, KingMoveLosesCastling)
+{
+  auto board = *readFenLine("r3k2r/8/8/8/8/8/8/R3K2R w KQkq - 0 1").boardPtr();
+  EXPECT_TRUE(board.canCastle());
+  board.makeMove(PieceMove(0, 4, Color::W|Piece::K, 0, 3));
+  board.makeMove(PieceMove(7, 4, Color::B|Piece::K, 7, 3));
+  board.makeMove(PieceMove(0, 3, Color::W|Piece::K, 0, 4));
+  board.makeMove(PieceMove(7, 3, Color::B|Piece::K, 7, 4));
+  EXPECT_FALSE(board.canCastle());
+  EXPECT_FALSE(board.canCastleLong());
+  EXPECT_EQ(0, board.kingInfo().castleBits());
+}
+
+//
+// test the squares attacked by each color
+//
+TEST(Board, Attacks)
+{
+  Board board;
+  EXPECT_EQ(0x0000000000ffff7eULL, board.attacks(Color::W));
+  EXPECT_EQ(0x7effff0000000000ULL, board.attacks(Color::B));
+
+  // the rook attacks the square behind the king it gives check to
+  board = *readFenLine("4r1k1/8/8/8/8/8/4K3/8 w - - 0 1").boardPtr();
+  EXPECT_TRUE(board.attacks(Color::B) & squareMask(0, 4));
+  EXPECT_FALSE(board.attacks(Color::W) & squareMask(7, 6));
+
+  // castling is not possible through an attacked square, but the rook may
+  // pass over one
+  board = *readFenLine("1r2k3/8/8/8/8/8/5r2/R3K2R w KQ - 0 1").boardPtr();
+  auto moveList = board.getMoves();
+  auto castle = std::count_if(moveList.begin(), moveList.end(),
+    [](const PieceMove &pm) { return pm.isCastle(); });
+  auto castleLong = std::count_if(moveList.begin(), moveList.end(),
+    [](const PieceMove &pm) { return pm.isCastleLong(); });
+  EXPECT_EQ(0, castle);
+  EXPECT_EQ(1, castleLong);
+}
+
 void
 playViennaGame(vector<PieceMove> &moveList)
 {
@@ -1886,4 +2394,93 @@ playViennaGame(vector<PieceMove> &moveList)
   moveList.back().xPiece(7, 5, Piece::K, Color::B);
 }
 
+//
+// create a new board with the same position, to compute its hash from scratch
+//
+Board
+rebuildBoard(const Board &board)
+{
+  vector<Square> squareList;
+  for (dim_t row = 0; row < BasicBoard::DIM; ++row) {
+    for (dim_t col = 0; col < BasicBoard::DIM; ++col) {
+      if (not notPiece(board(row, col).code()))
+        squareList.push_back(board(row, col));
+    }
+  }
+
+  return Board(squareList, board.nextTurn(), board.kingInfo(),
+               board.lastMove());
+}
+
+//
+// test the static exchange evaluation of captures
+//
+TEST(Board, See)
+{
+  // find a legal move by its long algebraic notation
+  auto findMove = [](const Board &board, const std::string &move) {
+    for (auto &pm : board.getLegalMoves())
+      if (algebraic(pm) == move)
+        return pm;
+    ADD_FAILURE() << "\tMove " << move << " is not legal";
+    return PieceMove();
+  };
+
+  std::pair<const char*, const char*> noDefense[] = {
+    {"1k1r4/1pp4p/p7/4p3/8/P5P1/1PP4P/2K1R3 w - - 0 1", "e1e5"},
+    {"4k3/8/8/3pP3/8/8/8/4K3 w - d6 0 1", "e5d6"}
+  };
+  for (auto &fenMove : noDefense) {
+    auto board = *readFenLine(fenMove.first).boardPtr();
+    EXPECT_EQ(100, board.see(findMove(board, fenMove.second)))
+      << "\t" << fenMove.first;
+  }
+
+  // x-rays behind the rook and the bishop
+  auto board = *readFenLine("1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 "
+                            "w - - 0 1").boardPtr();
+  EXPECT_EQ(-200, board.see(findMove(board, "d3e5")));
+
+  // a promotion that is recaptured, and one that is not
+  board = *readFenLine("r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1").boardPtr();
+  EXPECT_EQ(-100, board.see(findMove(board, "b7b8q")));
+  EXPECT_EQ(1300, board.see(findMove(board, "b7a8q")));
+
+  // the king only captures a piece that is not defended
+  board = *readFenLine("8/8/4k3/4p3/8/8/4R3/7K w - - 0 1").boardPtr();
+  EXPECT_EQ(-400, board.see(findMove(board, "e2e5")));
+  board = *readFenLine("8/8/4k3/4p3/8/8/4R3/4R2K w - - 0 1").boardPtr();
+  EXPECT_EQ(100, board.see(findMove(board, "e2e5")));
+
+  // quiet moves lose the piece if the square is attacked
+  board = Board();
+  EXPECT_EQ(0, board.see(findMove(board, "g1f3")));
+  board = *readFenLine("4k3/8/8/8/3p4/8/8/2B1K3 w - - 0 1").boardPtr();
+  EXPECT_EQ(-300, board.see(findMove(board, "c1e3")));
+}
+
+//
+// test that seeGE agrees with see
+//
+TEST(Board, SeeGE)
+{
+  const char *fenList[] = {
+    "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+    "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+    "1k1r3q/1ppn3p/p4b2/4p3/8/P2N2P1/1PP1R1BP/2K1Q3 w - - 0 1",
+    "r3k3/1P6/8/8/8/8/8/4K3 w - - 0 1",
+    "8/8/4k3/4p3/8/8/4R3/4R2K w - - 0 1"
+  };
+  for (auto fen : fenList) {
+    auto board = *readFenLine(fen).boardPtr();
+    for (auto &pm : board.getLegalMoves()) {
+      auto value = board.see(pm);
+      for (int threshold = -1500; threshold <= 1500; threshold += 50) {
+        EXPECT_EQ(value >= threshold, board.seeGE(pm, threshold))
+          << "\t" << fen << "\t" << algebraic(pm) << "\t" << threshold;
+      }
+    }
+  }
+}
+
 } // namespace zoor
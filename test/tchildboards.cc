@@ -0,0 +1,95 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tchildboards.cc
+//! @author Omar A Serrano
+//! @date 2016-10-24
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "boardinfo.hh"
+#include "childboards.hh"
+#include "iofen.hh"
+#include "piecemove.hh"
+#include "square.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// from STL
+//
+using std::vector;
+
+//
+// test that the children are the boards of getBoards, in the same order
+//
+TEST(ChildBoards, SameAsGetBoards)
+{
+  auto fenNames = {
+    "fen/whiteGetBoards.fen", "fen/blackGetBoards.fen",
+    "fen/canWhiteCastle.fen", "fen/enPassantForWhite.fen",
+    "fen/moveBlackPawn.fen"
+  };
+
+  for (auto fenName : fenNames) {
+    for (auto &fen : readFen(fenName)) {
+      const auto board = *fen.boardPtr();
+      auto boardList = board.getBoards();
+      ChildBoards children(board);
+      ASSERT_EQ(boardList.size(), children.size());
+
+      size_t i = 0;
+      for (auto &child : children) {
+        ASSERT_LT(i, boardList.size());
+        EXPECT_EQ(boardList[i], child) << "\tBoards are not equal: " << i;
+        EXPECT_EQ(boardList[i].hashCode(), child.hashCode());
+        EXPECT_EQ(boardList[i].lastMove(), child.lastMove());
+        EXPECT_EQ(children.move(i), child.lastMove());
+        ++i;
+      }
+      EXPECT_EQ(boardList.size(), i);
+    }
+  }
+}
+
+//
+// test a board without moves, and a loop that stops early
+//
+TEST(ChildBoards, EmptyAndEarlyExit)
+{
+  vector<Square> squareList = {{0, 0, Piece::K, Color::W}};
+  Board lonely(squareList, Color::B, BoardInfo(), PieceMove());
+  ChildBoards none(lonely);
+  EXPECT_EQ(0, none.size());
+  EXPECT_TRUE(none.begin() == none.end());
+
+  // the iterator sees the scratch board change as it moves on
+  Board board;
+  ChildBoards children(board);
+  auto it = children.begin();
+  auto first = it->lastMove();
+  EXPECT_EQ(children.move(0), first);
+  ++it;
+  EXPECT_NE(first, it->lastMove());
+  EXPECT_EQ(Color::B, it->nextTurn());
+
+  for (auto &child : ChildBoards(board)) {
+    if (child.lastMove().sPiece() == Piece::N)
+      break;
+  }
+  EXPECT_EQ(Board(), board);
+}
+
+} // namespace zoor
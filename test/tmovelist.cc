@@ -0,0 +1,107 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tmovelist.cc
+//! @author Omar A Serrano
+//! @date 2016-10-09
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "iofen.hh"
+#include "movelist.hh"
+#include "piecemove.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// test default ctor
+//
+TEST(MoveList, DefaultCtor)
+{
+  MoveList moveList;
+  EXPECT_TRUE(moveList.empty());
+  EXPECT_EQ(0, moveList.size());
+  EXPECT_EQ(moveList.begin(), moveList.end());
+}
+
+//
+// test emplace_back, push_back, back, pop_back, and clear
+//
+TEST(MoveList, AddAndRemove)
+{
+  MoveList moveList;
+  PieceMove pm1(1, 4, Color::W|Piece::P, 3, 4);
+  PieceMove pm2(0, 6, Color::W|Piece::N, 2, 5);
+
+  moveList.emplace_back(1, 4, Color::W|Piece::P, 3, 4);
+  EXPECT_EQ(1, moveList.size());
+  EXPECT_EQ(pm1, moveList.back());
+
+  moveList.push_back(pm2);
+  EXPECT_EQ(2, moveList.size());
+  EXPECT_EQ(pm1, moveList[0]);
+  EXPECT_EQ(pm2, moveList[1]);
+
+  moveList.back().xPiece(2, 5, Piece::P, Color::B);
+  EXPECT_TRUE(moveList[1].isCapture());
+
+  moveList.pop_back();
+  EXPECT_EQ(1, moveList.size());
+  EXPECT_EQ(pm1, moveList.back());
+
+  moveList.clear();
+  EXPECT_TRUE(moveList.empty());
+}
+
+//
+// test that the list can hold its capacity
+//
+TEST(MoveList, Capacity)
+{
+  MoveList moveList;
+  for (int i = 0; i < MoveList::CAPACITY; ++i)
+    moveList.emplace_back(1, i % 8, Color::W|Piece::P, 2, i % 8);
+
+  EXPECT_EQ(MoveList::CAPACITY, moveList.size());
+
+  int i = 0;
+  for (auto &pm : moveList)
+    EXPECT_EQ(i++ % 8, pm.sColumn());
+}
+
+//
+// test that Board::getMoves adds the same moves to a list as to a vector
+//
+TEST(MoveList, BoardGetMoves)
+{
+  for (auto fenName : {"fen/whiteGetMoves.fen", "fen/blackGetMoves.fen",
+                       "fen/makeMove.fen"}) {
+    for (auto &fen : readFen(fenName)) {
+      auto pb = fen.boardPtr();
+      auto moveVec = pb->getMoves();
+
+      MoveList moveList;
+      pb->getMoves(moveList);
+      EXPECT_EQ(moveVec,
+                std::vector<PieceMove>(moveList.begin(), moveList.end()));
+
+      // moves are appended to a list that is not empty
+      pb->getMoves(moveList);
+      EXPECT_EQ(2 * moveVec.size(), moveList.size());
+    }
+  }
+}
+
+} // namespace zoor
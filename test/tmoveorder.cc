@@ -0,0 +1,136 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tmoveorder.cc
+//! @author Omar A Serrano
+//! @date 2016-10-16
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "iofen.hh"
+#include "moveorder.hh"
+#include "movepicker.hh"
+#include "packedmove.hh"
+#include "piecemove.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// test the order of captures
+//
+TEST(MoveOrder, MvvLva)
+{
+  PieceMove pxq(3, 3, Color::W|Piece::P, 4, 4);
+  pxq.xPiece(4, 4, Piece::Q, Color::B);
+  PieceMove qxq(3, 3, Color::W|Piece::Q, 4, 4);
+  qxq.xPiece(4, 4, Piece::Q, Color::B);
+  PieceMove pxr(3, 3, Color::W|Piece::P, 4, 4);
+  pxr.xPiece(4, 4, Piece::R, Color::B);
+  PieceMove promo(6, 0, Color::W|Piece::P);
+  promo.dPiece(7, 0, Piece::Q, Color::W);
+
+  EXPECT_GT(MoveOrder::mvvLva(pxq), MoveOrder::mvvLva(qxq));
+  EXPECT_GT(MoveOrder::mvvLva(qxq), MoveOrder::mvvLva(pxr));
+  EXPECT_GT(MoveOrder::mvvLva(promo), MoveOrder::mvvLva(pxr));
+}
+
+//
+// test the killer moves
+//
+TEST(MoveOrder, Killers)
+{
+  MoveOrder order;
+  PieceMove move1(0, 6, Color::W|Piece::N, 2, 5);
+  PieceMove move2(1, 4, Color::W|Piece::P, 3, 4);
+  PieceMove move3(0, 1, Color::W|Piece::N, 2, 2);
+  EXPECT_TRUE(order.killer(3, 0).isNull());
+
+  order.addKiller(3, move1);
+  order.addKiller(3, move1);
+  EXPECT_EQ(PackedMove(move1), order.killer(3, 0));
+  EXPECT_TRUE(order.killer(3, 1).isNull());
+
+  order.addKiller(3, move2);
+  order.addKiller(3, move3);
+  EXPECT_EQ(PackedMove(move3), order.killer(3, 0));
+  EXPECT_EQ(PackedMove(move2), order.killer(3, 1));
+  EXPECT_TRUE(order.killer(2, 0).isNull());
+
+  order.clear();
+  EXPECT_TRUE(order.killer(3, 0).isNull());
+}
+
+//
+// test the history scores
+//
+TEST(MoveOrder, History)
+{
+  MoveOrder order;
+  PieceMove white(0, 6, Color::W|Piece::N, 2, 5);
+  PieceMove black(0, 6, Color::B|Piece::N, 2, 5);
+
+  order.addHistory(white, 100);
+  EXPECT_LT(0, order.history(white));
+  EXPECT_GE(100, order.history(white));
+  EXPECT_EQ(0, order.history(black));
+
+  // the score never goes past the largest magnitude
+  for (int i = 0; i < 1000; ++i)
+    order.addHistory(white, MoveOrder::HISTORY_MAX);
+  EXPECT_GE(MoveOrder::HISTORY_MAX, order.history(white));
+  for (int i = 0; i < 1000; ++i)
+    order.addHistory(white, -MoveOrder::HISTORY_MAX);
+  EXPECT_LE(-MoveOrder::HISTORY_MAX, order.history(white));
+  EXPECT_GT(0, order.history(white));
+}
+
+//
+// test the countermoves, and that the picker uses the tables
+//
+TEST(MoveOrder, CounterMove)
+{
+  MoveOrder order;
+  auto board = *readFenLine("rnbqkbnr/pppppppp/8/8/4P3/8/PPPP1PPP/RNBQKBNR b "
+                            "KQkq - 0 1").boardPtr();
+  EXPECT_TRUE(order.counterMove(board.lastMove()).isNull());
+  EXPECT_TRUE(order.counterMove(PieceMove()).isNull());
+
+  PieceMove e4(1, 4, Color::W|Piece::P, 3, 4);
+  board = Board().makeMoveCopy(e4);
+  PieceMove c5(6, 2, Color::B|Piece::P, 4, 2);
+  PieceMove nc6(7, 1, Color::B|Piece::N, 5, 2);
+  PieceMove a6(6, 0, Color::B|Piece::P, 5, 0);
+  PieceMove h6(6, 7, Color::B|Piece::P, 5, 7);
+  order.setCounterMove(board.lastMove(), c5);
+  EXPECT_EQ(PackedMove(c5), order.counterMove(board.lastMove()));
+
+  order.addKiller(1, nc6);
+  order.addHistory(a6, 1000);
+  order.addHistory(h6, 500);
+
+  // the killer, the countermove, then the quiet moves by history
+  MovePicker picker(board, PackedMove(), order, 1);
+  std::vector<PieceMove> pickList;
+  PieceMove pm;
+  while (picker.next(pm))
+    pickList.push_back(pm);
+  ASSERT_EQ(20, pickList.size());
+  EXPECT_EQ(nc6, pickList[0]);
+  EXPECT_EQ(c5, pickList[1]);
+  EXPECT_EQ(a6, pickList[2]);
+  EXPECT_EQ(h6, pickList[3]);
+}
+
+} // namespace zoor
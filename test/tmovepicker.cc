@@ -0,0 +1,151 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tmovepicker.cc
+//! @author Omar A Serrano
+//! @date 2016-10-16
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <algorithm>
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "iofen.hh"
+#include "movelist.hh"
+#include "movepicker.hh"
+#include "packedmove.hh"
+#include "piecemove.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+namespace {
+
+const char *FEN_LIST[] = {
+  "rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+  "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+  "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+  "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+  "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8"
+};
+
+//
+// all the moves picked
+//
+std::vector<PieceMove>
+pickAll(MovePicker &picker)
+{
+  std::vector<PieceMove> moveList;
+  PieceMove pm;
+  while (picker.next(pm))
+    moveList.push_back(pm);
+  return moveList;
+}
+
+//
+// the legal moves, sorted to compare them
+//
+std::vector<PackedMove::data_type>
+sorted(const std::vector<PieceMove> &moveList)
+{
+  std::vector<PackedMove::data_type> dataList;
+  for (auto &pm : moveList)
+    dataList.push_back(PackedMove(pm).data());
+  std::sort(dataList.begin(), dataList.end());
+  return dataList;
+}
+
+} // namespace
+
+//
+// test that every legal move is picked once
+//
+TEST(MovePicker, AllMoves)
+{
+  for (auto fen : FEN_LIST) {
+    auto board = *readFenLine(fen).boardPtr();
+    auto legalList = board.getLegalMoves();
+    ASSERT_FALSE(legalList.empty());
+
+    MovePicker picker(board, PackedMove());
+    EXPECT_EQ(sorted(legalList), sorted(pickAll(picker))) << "\t" << fen;
+
+    // with the last move as the table move, and the first as a killer
+    PackedMove killers[MovePicker::KILLERS] = {
+      PackedMove(legalList.front()), PackedMove(legalList.front())
+    };
+    MovePicker picker2(board, PackedMove(legalList.back()), killers);
+    auto pickList = pickAll(picker2);
+    EXPECT_EQ(legalList.back(), pickList.front()) << "\t" << fen;
+    EXPECT_EQ(sorted(legalList), sorted(pickList)) << "\t" << fen;
+
+    // no more moves after the last
+    PieceMove pm;
+    EXPECT_FALSE(picker2.next(pm));
+  }
+}
+
+//
+// test the order of the stages
+//
+TEST(MovePicker, Order)
+{
+  auto board = *readFenLine(FEN_LIST[1]).boardPtr();
+  auto legalList = board.getLegalMoves();
+
+  // a quiet move as a killer, and a move that is not legal here
+  auto killer = std::find_if(legalList.begin(), legalList.end(),
+    [](const PieceMove &pm) { return algebraic(pm) == "a2a3"; });
+  ASSERT_NE(legalList.end(), killer);
+  PackedMove illegal(PieceMove(1, 4, Color::W|Piece::P, 3, 4));
+  PackedMove killers[MovePicker::KILLERS] = {illegal, PackedMove(*killer)};
+
+  MovePicker picker(board, illegal, killers);
+  auto pickList = pickAll(picker);
+  ASSERT_EQ(legalList.size(), pickList.size());
+
+  // the captures come first, the most valuable victim first
+  size_t captures = 0;
+  while (pickList[captures].isCapture())
+    ++captures;
+  EXPECT_EQ(8, captures);
+  EXPECT_EQ(Piece::B, pickList[0].xPiece());
+  for (size_t i = 1; i < captures; ++i)
+    EXPECT_GE(pickList[i - 1].xPiece(), pickList[i].xPiece());
+
+  // then the killer, then the quiet moves
+  EXPECT_EQ(*killer, pickList[captures]);
+  for (size_t i = captures; i < pickList.size(); ++i)
+    EXPECT_FALSE(pickList[i].isCapture());
+}
+
+//
+// test the picker of a quiescence search
+//
+TEST(MovePicker, CapturesOnly)
+{
+  for (auto fen : FEN_LIST) {
+    auto board = *readFenLine(fen).boardPtr();
+    MoveList captures;
+    board.getLegalMoves(captures, Board::GenType::CAPTURES);
+
+    // in check, every evasion is picked
+    std::vector<PieceMove> expected(captures.begin(), captures.end());
+    if (board.inCheck())
+      expected = board.getLegalMoves();
+
+    MovePicker picker(board);
+    EXPECT_EQ(sorted(expected), sorted(pickAll(picker))) << "\t" << fen;
+  }
+}
+
+} // namespace zoor
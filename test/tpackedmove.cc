@@ -0,0 +1,100 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tpackedmove.cc
+//! @author Omar A Serrano
+//! @date 2016-10-10
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "iofen.hh"
+#include "packedmove.hh"
+#include "piecemove.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// test default ctor
+//
+TEST(PackedMove, DefaultCtor)
+{
+  PackedMove pm;
+  EXPECT_TRUE(pm.isNull());
+  EXPECT_EQ(0, pm.data());
+  EXPECT_EQ(Color::NONE, pm.color());
+  EXPECT_EQ(PieceMove(), pm.toPieceMove());
+  EXPECT_EQ(pm, PackedMove(PieceMove()));
+}
+
+//
+// test the fields of a packed move
+//
+TEST(PackedMove, Fields)
+{
+  PieceMove pMove(6, 1, Color::W|Piece::P);
+  pMove.xPiece(7, 0, Piece::R, Color::B);
+  pMove.dPiece(7, 0, Piece::Q, Color::W);
+  PackedMove pm(pMove);
+
+  EXPECT_FALSE(pm.isNull());
+  EXPECT_EQ(49, pm.from());
+  EXPECT_EQ(56, pm.to());
+  EXPECT_EQ(Piece::P, pm.piece());
+  EXPECT_EQ(Color::W, pm.color());
+  EXPECT_EQ(Piece::R, pm.captured());
+  EXPECT_EQ(Piece::Q, pm.promo());
+  EXPECT_TRUE(pm.isCapture());
+  EXPECT_TRUE(pm.isPromo());
+  EXPECT_FALSE(pm.isCastle());
+  EXPECT_FALSE(pm.isCastleLong());
+  EXPECT_FALSE(pm.isEnPassant());
+  EXPECT_EQ(pm, PackedMove::fromData(pm.data()));
+
+  pMove = PieceMove(7, 4, Color::B|Piece::K, 7, 2);
+  pMove.xPiece(7, 0, Piece::R, Color::B);
+  pm = PackedMove(pMove);
+  EXPECT_EQ(Color::B, pm.color());
+  EXPECT_FALSE(pm.isCapture());
+  EXPECT_TRUE(pm.isCastleLong());
+
+  pMove = PieceMove(3, 4, Color::B|Piece::P, 2, 3);
+  pMove.xPiece(3, 3, Piece::P, Color::W);
+  pm = PackedMove(pMove);
+  EXPECT_TRUE(pm.isCapture());
+  EXPECT_TRUE(pm.isEnPassant());
+}
+
+//
+// test conversion to and from PieceMove for moves made by Board
+//
+TEST(PackedMove, ToPieceMove)
+{
+  auto fenNames = {
+    "fen/makeMove.fen", "fen/canWhiteCastle.fen", "fen/canBlackCastle.fen",
+    "fen/enPassantForWhite.fen", "fen/enPassantForBlack.fen",
+    "fen/moveWhitePawn.fen", "fen/moveBlackPawn.fen"
+  };
+
+  for (auto fenName : fenNames) {
+    for (auto &fen : readFen(fenName)) {
+      for (auto &pMove : fen.boardPtr()->getMoves()) {
+        PackedMove pm(pMove);
+        EXPECT_EQ(pMove, pm.toPieceMove()) << "\tPacked move: " << pm;
+        EXPECT_EQ(pMove.isCapture(), pm.isCapture());
+        EXPECT_EQ(pMove.isPromo(), pm.isPromo());
+        EXPECT_EQ(pMove.isCastle(), pm.isCastle());
+        EXPECT_EQ(pMove.isCastleLong(), pm.isCastleLong());
+        EXPECT_EQ(pMove.isEnPassant(), pm.isEnPassant());
+      }
+    }
+  }
+}
+
+} // namespace zoor
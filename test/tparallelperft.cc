@@ -0,0 +1,108 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tparallelperft.cc
+//! @author Omar A Serrano
+//! @date 2016-10-25
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// zoor
+//
+#include "board.hh"
+#include "fenrecord.hh"
+#include "iofen.hh"
+#include "parallelperft.hh"
+#include "perft.hh"
+#include "perfttable.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// the largest count checked, to keep the tests fast
+//
+const node_t MAX_PARALLEL_NODES = 1000000;
+
+//
+// test perft with a table against the reference positions
+//
+TEST(ParallelPerft, TablePerft)
+{
+  PerftTable table(4);
+  for (auto &record : readPerft("fen/perft.fen")) {
+    auto board = *readFenLine(record.fen).boardPtr();
+    const auto before = board;
+
+    EXPECT_EQ(1, perft(board, 0, table));
+    for (size_t i = 0; i < record.counts.size(); ++i) {
+      if (record.counts[i] > MAX_PARALLEL_NODES)
+        break;
+      EXPECT_EQ(record.counts[i], perft(board, i + 1, table))
+        << "\tPosition " << record.fen << " at depth " << i + 1;
+    }
+    EXPECT_EQ(before, board);
+  }
+}
+
+//
+// test the parallel counts against the reference positions, with one thread
+// and with several threads
+//
+TEST(ParallelPerft, ReferencePositions)
+{
+  for (unsigned threads : {1u, 4u}) {
+    PerftTable table(4);
+    ParallelPerft parallel(table, threads);
+    EXPECT_EQ(threads, parallel.threads());
+
+    for (auto &record : readPerft("fen/perft.fen")) {
+      const auto board = *readFenLine(record.fen).boardPtr();
+      EXPECT_EQ(1, parallel.run(board, 0));
+      for (size_t i = 0; i < record.counts.size(); ++i) {
+        if (record.counts[i] > MAX_PARALLEL_NODES)
+          break;
+        EXPECT_EQ(record.counts[i], parallel.run(board, i + 1))
+          << "\tPosition " << record.fen << " at depth " << i + 1
+          << " with " << threads << " threads";
+      }
+    }
+  }
+}
+
+//
+// test that divide gives the same moves and counts as perftDivide
+//
+TEST(ParallelPerft, Divide)
+{
+  PerftTable table(4);
+  ParallelPerft parallel(table, 3);
+  for (auto &record : readPerft("fen/perft.fen")) {
+    auto board = *readFenLine(record.fen).boardPtr();
+    for (int depth = 1; depth <= 3; ++depth) {
+      auto expected = perftDivide(board, depth);
+      auto actual = parallel.divide(board, depth);
+      ASSERT_EQ(expected.size(), actual.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        EXPECT_EQ(expected[i].first, actual[i].first);
+        EXPECT_EQ(expected[i].second, actual[i].second)
+          << "\tPosition " << record.fen << " at depth " << depth;
+      }
+    }
+  }
+}
+
+//
+// test that no threads is the same as one thread
+//
+TEST(ParallelPerft, ZeroThreads)
+{
+  PerftTable table(1);
+  ParallelPerft parallel(table, 0);
+  EXPECT_EQ(1, parallel.threads());
+  EXPECT_EQ(8902, parallel.run(Board(), 3));
+}
+
+} // namespace zoor
@@ -0,0 +1,141 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tparallelsearch.cc
+//! @author Omar A Serrano
+//! @date 2016-10-14
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <algorithm>
+#include <memory>
+#include <thread>
+#include <vector>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "iofen.hh"
+#include "istrategy.hh"
+#include "materialstrategy.hh"
+#include "packedmove.hh"
+#include "parallelsearch.hh"
+#include "piecemove.hh"
+#include "search.hh"
+#include "transtable.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+namespace {
+
+//
+// creates a strategy for each thread
+//
+std::unique_ptr<IStrategy>
+makeStrategy()
+{
+  return std::unique_ptr<IStrategy>(new MaterialStrategy);
+}
+
+} // namespace
+
+//
+// test that threads storing and probing the same buckets never see an entry
+// with the data of another position
+//
+TEST(ParallelSearch, TransTableRace)
+{
+  TransTable table(0, TransTable::Replace::ALWAYS);
+  const int THREADS = 4;
+  const int STORES = 20000;
+
+  // every key falls in the one bucket, and its score is derived from the key
+  auto key = [](int i) { return TransTable::key_type(i) << 20; };
+  auto score = [](int i) { return i % 30000; };
+
+  std::vector<int> badEntries(THREADS, 0);
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < STORES; ++i) {
+        int k = i * THREADS + t + 1;
+        table.store(key(k), 1, Bound::EXACT, score(k), PackedMove());
+        for (int j = 1; j <= THREADS * 2; ++j) {
+          TransEntry entry;
+          int other = std::max(1, k - j);
+          if (table.probe(key(other), entry) and entry.score() != score(other))
+            ++badEntries[t];
+        }
+      }
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (auto bad : badEntries)
+    EXPECT_EQ(0, bad);
+}
+
+//
+// test a mate in one with several threads
+//
+TEST(ParallelSearch, MateInOne)
+{
+  TransTable table(1);
+  ParallelSearch search(makeStrategy, table, 4);
+  EXPECT_EQ(4, search.threads());
+
+  auto board = *readFenLine("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1").boardPtr();
+  SearchLimits limits;
+  limits.depth = 4;
+  auto result = search.run(board, limits);
+
+  EXPECT_EQ(Search::MATE_SCORE - 1, result.score);
+  ASSERT_FALSE(result.pv.empty());
+  EXPECT_EQ("a1a8", algebraic(result.pv[0]));
+}
+
+//
+// test that the threads return a legal move and count all the nodes
+//
+TEST(ParallelSearch, Run)
+{
+  TransTable table(4);
+  auto board = *readFenLine("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/"
+                            "R3K2R w KQkq - 0 1").boardPtr();
+  const auto before = board;
+
+  SearchLimits limits;
+  limits.depth = 4;
+  ParallelSearch single(makeStrategy, table, 1);
+  auto singleResult = single.run(board, limits);
+  EXPECT_EQ(4, singleResult.depth);
+
+  table.clear();
+  ParallelSearch search(makeStrategy, table, 3);
+  auto result = search.run(board, limits);
+  EXPECT_EQ(before, board);
+  EXPECT_EQ(4, result.depth);
+  ASSERT_FALSE(result.pv.empty());
+
+  auto moveList = board.getMoves();
+  EXPECT_NE(moveList.end(),
+            std::find(moveList.begin(), moveList.end(), result.pv[0]));
+
+  // the node limit is shared by the threads
+  limits.depth = Search::MAX_PLY;
+  limits.nodes = 30000;
+  result = search.run(board, limits);
+  EXPECT_LE(1, result.depth);
+  EXPECT_FALSE(result.pv.empty());
+  EXPECT_LT(0, result.nodes);
+}
+
+} // namespace zoor
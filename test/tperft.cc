@@ -0,0 +1,81 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tperft.cc
+//! @author Omar A Serrano
+//! @date 2016-10-11
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// zoor
+//
+#include "board.hh"
+#include "fenrecord.hh"
+#include "iofen.hh"
+#include "perft.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// the largest count checked, to keep the tests fast
+//
+const node_t MAX_NODES = 100000;
+
+//
+// test readPerft
+//
+TEST(Perft, ReadPerft)
+{
+  auto recordList = readPerft("fen/perft.fen");
+
+  EXPECT_EQ(6, recordList.size());
+  EXPECT_EQ(6, recordList[0].counts.size());
+  EXPECT_EQ(20, recordList[0].counts[0]);
+  EXPECT_EQ(400, recordList[0].counts[1]);
+}
+
+//
+// test perft with the reference positions
+//
+TEST(Perft, ReferencePositions)
+{
+  for (auto &record : readPerft("fen/perft.fen")) {
+    auto board = *readFenLine(record.fen).boardPtr();
+    const auto before = board;
+
+    EXPECT_EQ(1, perft(board, 0));
+    for (size_t i = 0; i < record.counts.size(); ++i) {
+      if (record.counts[i] > MAX_NODES)
+        break;
+      EXPECT_EQ(record.counts[i], perft(board, i + 1))
+        << "\tPosition " << record.fen << " at depth " << i + 1;
+    }
+
+    // the board is left in the same position
+    EXPECT_EQ(before, board);
+    EXPECT_EQ(before.hashCode(), board.hashCode());
+  }
+}
+
+//
+// test perftDivide
+//
+TEST(Perft, Divide)
+{
+  for (auto &record : readPerft("fen/perft.fen")) {
+    auto board = *readFenLine(record.fen).boardPtr();
+    auto divideList = perftDivide(board, 2);
+
+    EXPECT_EQ(record.counts[0], divideList.size());
+
+    node_t nodes = 0;
+    for (auto &moveCount : divideList)
+      nodes += moveCount.second;
+    EXPECT_EQ(record.counts[1], nodes);
+  }
+}
+
+} // namespace zoor
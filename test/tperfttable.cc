@@ -0,0 +1,93 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tperfttable.cc
+//! @author Omar A Serrano
+//! @date 2016-10-25
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "perfttable.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// test the size of the table
+//
+TEST(PerftTable, Size)
+{
+  PerftTable table(1);
+  EXPECT_EQ((1u << 20) / 64 * PerftTable::BUCKET_SIZE, table.size());
+
+  table.resize(2);
+  EXPECT_EQ((2u << 20) / 64 * PerftTable::BUCKET_SIZE, table.size());
+
+  PerftTable tiny(0);
+  EXPECT_EQ(PerftTable::BUCKET_SIZE, tiny.size());
+}
+
+//
+// test probe and store
+//
+TEST(PerftTable, ProbeAndStore)
+{
+  PerftTable table(1);
+  node_t nodes = 0;
+  EXPECT_FALSE(table.probe(0x1234, 3, nodes));
+
+  table.store(0x1234, 3, 8902);
+  EXPECT_TRUE(table.probe(0x1234, 3, nodes));
+  EXPECT_EQ(8902, nodes);
+
+  // a different depth or key is a miss
+  EXPECT_FALSE(table.probe(0x1234, 2, nodes));
+  EXPECT_FALSE(table.probe(0x4321, 3, nodes));
+
+  // the same key at another depth is kept in the same bucket
+  table.store(0x1234, 4, 197281);
+  EXPECT_TRUE(table.probe(0x1234, 3, nodes));
+  EXPECT_EQ(8902, nodes);
+  EXPECT_TRUE(table.probe(0x1234, 4, nodes));
+  EXPECT_EQ(197281, nodes);
+
+  // the largest count fits, a larger one is not stored
+  table.store(0x5678, 9, PerftTable::MAX_NODES);
+  EXPECT_TRUE(table.probe(0x5678, 9, nodes));
+  EXPECT_EQ(PerftTable::MAX_NODES, nodes);
+  table.store(0x9abc, 9, PerftTable::MAX_NODES + 1);
+  EXPECT_FALSE(table.probe(0x9abc, 9, nodes));
+
+  table.clear();
+  EXPECT_FALSE(table.probe(0x1234, 3, nodes));
+  EXPECT_FALSE(table.probe(0x5678, 9, nodes));
+}
+
+//
+// test that a full bucket replaces the shallowest entry
+//
+TEST(PerftTable, ReplaceShallowest)
+{
+  PerftTable table(0);
+  node_t nodes = 0;
+
+  // with one bucket, every key goes to the same bucket
+  for (int i = 0; i < PerftTable::BUCKET_SIZE; ++i)
+    table.store(i + 1, i + 2, i + 100);
+  table.store(99, 9, 999);
+
+  EXPECT_FALSE(table.probe(1, 2, nodes));
+  for (int i = 1; i < PerftTable::BUCKET_SIZE; ++i) {
+    EXPECT_TRUE(table.probe(i + 1, i + 2, nodes));
+    EXPECT_EQ(i + 100, nodes);
+  }
+  EXPECT_TRUE(table.probe(99, 9, nodes));
+  EXPECT_EQ(999, nodes);
+}
+
+} // namespace zoor
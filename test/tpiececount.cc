@@ -17,6 +17,7 @@
 #include "basictypes.hh"
 #include "board.hh"
 #include "piececount.hh"
+#include "piecemove.hh"
 #include "square.hh"
 
 //
@@ -226,6 +227,32 @@ TEST(PieceCount, Count)
   EXPECT_TRUE(pc.good());
 }
 
+//
+// Test that counting a board gives the same count as its list of pieces
+//
+TEST(PieceCount, CountBoardAsSquares)
+{
+  Board board;
+  board.makeMove(PieceMove(1, 4, Color::W|Piece::P, 3, 4));
+  board.makeMove(PieceMove(6, 3, Color::B|Piece::P, 4, 3));
+  PieceMove pm(3, 4, Color::W|Piece::P, 4, 3);
+  pm.xPiece(4, 3, Piece::P, Color::B);
+  board.makeMove(pm);
+
+  vector<Square> sqList;
+  for (dim_t row = 0; row < 8; ++row) {
+    for (dim_t col = 0; col < 8; ++col) {
+      if (not notPiece(board(row, col).code()))
+        sqList.push_back(board(row, col));
+    }
+  }
+
+  PieceCount pc(board);
+  EXPECT_EQ(PieceCount(sqList), pc);
+  EXPECT_EQ(8, pc.wPawn());
+  EXPECT_EQ(7, pc.bPawn());
+}
+
 //
 // Test clear
 //
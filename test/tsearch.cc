@@ -0,0 +1,215 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file tsearch.cc
+//! @author Omar A Serrano
+//! @date 2016-10-12
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// STL
+//
+#include <algorithm>
+#include <chrono>
+#include <string>
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "fenrecord.hh"
+#include "iofen.hh"
+#include "istrategy.hh"
+#include "materialstrategy.hh"
+#include "movelist.hh"
+#include "moveundo.hh"
+#include "piecemove.hh"
+#include "search.hh"
+#include "transtable.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+namespace {
+
+//
+// search a position given in FEN notation
+//
+SearchResult
+searchFen(const std::string &fen, const SearchLimits &limits)
+{
+  MaterialStrategy strategy;
+  Search search(strategy);
+  auto board = *readFenLine(fen).boardPtr();
+  return search.run(board, limits);
+}
+
+} // namespace
+
+//
+// test a mate in one
+//
+TEST(Search, MateInOne)
+{
+  SearchLimits limits;
+  limits.depth = 4;
+  auto result = searchFen("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1", limits);
+
+  EXPECT_EQ(Search::MATE_SCORE - 1, result.score);
+  EXPECT_TRUE(Search::isMate(result.score));
+  // the mate is seen by the quiescence search of the reply of the mated player
+  EXPECT_EQ(1, result.depth);
+  ASSERT_EQ(1, result.pv.size());
+  EXPECT_EQ("a1a8", algebraic(result.pv[0]));
+}
+
+//
+// test positions without legal moves
+//
+TEST(Search, NoLegalMoves)
+{
+  SearchLimits limits;
+  limits.depth = 3;
+
+  auto result = searchFen("R5k1/5ppp/8/8/8/8/8/6K1 b - - 0 1", limits);
+  EXPECT_EQ(-Search::MATE_SCORE, result.score);
+  EXPECT_TRUE(result.pv.empty());
+
+  result = searchFen("7k/5Q2/6K1/8/8/8/8/8 b - - 0 1", limits);
+  EXPECT_EQ(0, result.score);
+  EXPECT_TRUE(result.pv.empty());
+}
+
+//
+// test that the search wins material
+//
+TEST(Search, WinMaterial)
+{
+  SearchLimits limits;
+  limits.depth = 3;
+  auto result = searchFen("4k3/8/8/3q4/8/8/8/3RK3 w - - 0 1", limits);
+
+  EXPECT_EQ(3, result.depth);
+  EXPECT_EQ(500, result.score);
+  ASSERT_FALSE(result.pv.empty());
+  EXPECT_EQ("d1d5", algebraic(result.pv[0]));
+}
+
+//
+// test that the leaves are not scored in the middle of an exchange
+//
+TEST(Search, Quiescence)
+{
+  SearchLimits limits;
+  limits.depth = 1;
+
+  // the pawn is defended, so taking it with the queen loses the queen
+  auto result = searchFen("4k3/8/4p3/3p4/8/8/8/3QK3 w - - 0 1", limits);
+  EXPECT_EQ(1, result.depth);
+  EXPECT_EQ(700, result.score);
+  ASSERT_EQ(1, result.pv.size());
+  EXPECT_NE("d1d5", algebraic(result.pv[0]));
+
+  // a quiet position scores the same as without a quiescence search
+  result = searchFen("4k3/8/8/8/8/8/8/3RK3 w - - 0 1", limits);
+  EXPECT_EQ(500, result.score);
+}
+
+//
+// test that the principal variation is a sequence of legal moves
+//
+TEST(Search, PrincipalVariation)
+{
+  MaterialStrategy strategy;
+  Search search(strategy);
+  auto board = *readFenLine("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/"
+                            "R3K2R w KQkq - 0 1").boardPtr();
+  const auto before = board;
+
+  SearchLimits limits;
+  limits.depth = 3;
+  auto result = search.run(board, limits);
+
+  EXPECT_EQ(before, board);
+  EXPECT_EQ(3, result.depth);
+  EXPECT_EQ(3, result.pv.size());
+  EXPECT_LT(0, result.nodes);
+
+  for (auto &pm : result.pv) {
+    MoveList moveList;
+    board.getMoves(moveList);
+    EXPECT_NE(moveList.end(), std::find(moveList.begin(), moveList.end(), pm))
+      << "\tMove " << algebraic(pm) << " is not valid";
+
+    MoveUndo undo;
+    board.makeMove(pm, undo);
+    EXPECT_FALSE(board.isKingAttacked(~board.nextTurn()))
+      << "\tMove " << algebraic(pm) << " leaves the king in check";
+  }
+}
+
+//
+// test the node and time limits
+//
+TEST(Search, Limits)
+{
+  SearchLimits limits;
+  limits.depth = Search::MAX_PLY;
+  limits.nodes = 5000;
+  auto result = searchFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                          limits);
+
+  EXPECT_GE(limits.nodes, result.nodes);
+  EXPECT_LE(1, result.depth);
+  EXPECT_FALSE(result.pv.empty());
+
+  limits.nodes = 0;
+  limits.time = std::chrono::milliseconds(50);
+  result = searchFen("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1",
+                     limits);
+
+  EXPECT_GT(1.0, result.seconds);
+  EXPECT_LE(1, result.depth);
+  EXPECT_FALSE(result.pv.empty());
+}
+
+//
+// test a search with a transposition table
+//
+TEST(Search, TransTable)
+{
+  MaterialStrategy strategy;
+  TransTable table(1);
+  Search search(strategy);
+  Search tableSearch(strategy, table);
+  auto board = *readFenLine("r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/"
+                            "R3K2R w KQkq - 0 1").boardPtr();
+  const auto before = board;
+
+  SearchLimits limits;
+  limits.depth = 4;
+  auto result = search.run(board, limits);
+  auto tableResult = tableSearch.run(board, limits);
+
+  EXPECT_EQ(before, board);
+  EXPECT_EQ(4, tableResult.depth);
+  EXPECT_GT(result.nodes, tableResult.nodes);
+  EXPECT_LT(0, table.hashfull());
+  ASSERT_FALSE(tableResult.pv.empty());
+
+  // a second search starts from the entries of the first
+  auto nextResult = tableSearch.run(board, limits);
+  EXPECT_GT(tableResult.nodes, nextResult.nodes);
+  EXPECT_EQ(tableResult.score, nextResult.score);
+
+  board = *readFenLine("6k1/5ppp/8/8/8/8/8/R5K1 w - - 0 1").boardPtr();
+  result = tableSearch.run(board, limits);
+  EXPECT_EQ(Search::MATE_SCORE - 1, result.score);
+  ASSERT_FALSE(result.pv.empty());
+  EXPECT_EQ("a1a8", algebraic(result.pv[0]));
+}
+
+} // namespace zoor
@@ -0,0 +1,151 @@
+/////////////////////////////////////////////////////////////////////////////////////
+//! @file ttranstable.cc
+//! @author Omar A Serrano
+//! @date 2016-10-13
+/////////////////////////////////////////////////////////////////////////////////////
+
+//
+// zoor
+//
+#include "basictypes.hh"
+#include "board.hh"
+#include "iofen.hh"
+#include "packedmove.hh"
+#include "piecemove.hh"
+#include "transtable.hh"
+
+//
+// gtest
+//
+#include "gtest/gtest.h"
+
+namespace zoor {
+
+//
+// test the fields of an entry
+//
+TEST(TransEntry, Fields)
+{
+  TransEntry entry;
+  EXPECT_TRUE(entry.empty());
+  EXPECT_EQ(Bound::NONE, entry.bound());
+  EXPECT_TRUE(entry.move().isNull());
+
+  PackedMove pm(PieceMove(1, 4, Color::W|Piece::P, 3, 4));
+  entry = TransEntry(0xabcdef, 17, Bound::LOWER, -30990, pm, 63);
+  EXPECT_FALSE(entry.empty());
+  EXPECT_EQ(0xabcdef, entry.key());
+  EXPECT_EQ(17, entry.depth());
+  EXPECT_EQ(Bound::LOWER, entry.bound());
+  EXPECT_EQ(-30990, entry.score());
+  EXPECT_EQ(pm, entry.move());
+  EXPECT_EQ(63, entry.generation());
+
+  entry = TransEntry(1, 255, Bound::EXACT, 32767, PackedMove(), 0);
+  EXPECT_EQ(255, entry.depth());
+  EXPECT_EQ(Bound::EXACT, entry.bound());
+  EXPECT_EQ(32767, entry.score());
+  EXPECT_TRUE(entry.move().isNull());
+}
+
+//
+// test the size of the table
+//
+TEST(TransTable, Size)
+{
+  TransTable table(1);
+  EXPECT_EQ(1 << 20, table.size() * sizeof(TransEntry));
+  EXPECT_EQ(TransTable::Replace::DEPTH, table.policy());
+
+  // rounded down to a power of two
+  table.resize(3);
+  EXPECT_EQ(2 << 20, table.size() * sizeof(TransEntry));
+
+  // at least one bucket
+  table.resize(0);
+  EXPECT_EQ(TransTable::BUCKET_SIZE, table.size());
+}
+
+//
+// test storing and finding entries
+//
+TEST(TransTable, ProbeAndStore)
+{
+  TransTable table(1);
+  auto board = *readFenLine("rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR "
+                            "w KQkq - 0 1").boardPtr();
+  auto key = board.hashCode();
+  PackedMove pm(board.getMoves().front());
+
+  TransEntry entry;
+  EXPECT_FALSE(table.probe(key, entry));
+  EXPECT_EQ(0, table.hashfull());
+
+  table.store(key, 5, Bound::EXACT, 42, pm);
+  ASSERT_TRUE(table.probe(key, entry));
+  EXPECT_EQ(key, entry.key());
+  EXPECT_EQ(5, entry.depth());
+  EXPECT_EQ(Bound::EXACT, entry.bound());
+  EXPECT_EQ(42, entry.score());
+  EXPECT_EQ(pm, entry.move());
+
+  // the move is kept when the new move is null
+  table.store(key, 6, Bound::UPPER, 10, PackedMove());
+  ASSERT_TRUE(table.probe(key, entry));
+  EXPECT_EQ(6, entry.depth());
+  EXPECT_EQ(Bound::UPPER, entry.bound());
+  EXPECT_EQ(pm, entry.move());
+
+  table.clear();
+  EXPECT_FALSE(table.probe(key, entry));
+}
+
+//
+// test the replacement policies
+//
+TEST(TransTable, Replace)
+{
+  // keys that differ only above the mask fall in the same bucket
+  auto key = [](int i) { return (TransTable::key_type(i) << 40) | 7; };
+  const int FULL = TransTable::BUCKET_SIZE;
+
+  TransTable table(1, TransTable::Replace::DEPTH);
+  TransEntry entry;
+  for (int i = 0; i < FULL; ++i)
+    table.store(key(i), 10 + i, Bound::EXACT, i, PackedMove());
+
+  // a shallower entry does not replace deeper entries of the same search
+  table.store(key(FULL), 5, Bound::EXACT, 0, PackedMove());
+  EXPECT_FALSE(table.probe(key(FULL), entry));
+
+  // an entry from a deeper search of the same position is kept
+  table.store(key(0), 3, Bound::LOWER, 0, PackedMove());
+  ASSERT_TRUE(table.probe(key(0), entry));
+  EXPECT_EQ(10, entry.depth());
+
+  // a deep enough entry replaces the shallowest one
+  table.store(key(FULL), 10, Bound::EXACT, 0, PackedMove());
+  EXPECT_TRUE(table.probe(key(FULL), entry));
+  EXPECT_FALSE(table.probe(key(0), entry));
+
+  // entries from an older search are replaced first
+  table.newSearch();
+  EXPECT_EQ(0, table.hashfull());
+  table.store(key(FULL + 1), 1, Bound::EXACT, 0, PackedMove());
+  EXPECT_TRUE(table.probe(key(FULL + 1), entry));
+  EXPECT_FALSE(table.probe(key(FULL), entry));
+
+  TransTable always(1, TransTable::Replace::ALWAYS);
+  for (int i = 0; i < FULL; ++i)
+    always.store(key(i), 10 + i, Bound::EXACT, i, PackedMove());
+
+  always.store(key(FULL), 5, Bound::EXACT, 0, PackedMove());
+  EXPECT_TRUE(always.probe(key(FULL), entry));
+  EXPECT_FALSE(always.probe(key(0), entry));
+
+  always.store(key(1), 3, Bound::LOWER, 0, PackedMove());
+  ASSERT_TRUE(always.probe(key(1), entry));
+  EXPECT_EQ(3, entry.depth());
+}
+
+} // namespace zoor